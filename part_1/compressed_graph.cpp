@@ -0,0 +1,197 @@
+#include "compressed_graph.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+void CompressedGraph::write_varint(std::vector<std::uint8_t>& out, std::uint32_t value)
+{
+    while (value >= 0x80)
+    {
+        out.push_back(static_cast<std::uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<std::uint8_t>(value));
+}
+
+/*
+Encode every vertex:
+1. Copy its (target, weight) pairs and sort them by target (stable, so parallel edges keep their order).
+2. Write the degree, then the target deltas and the weights as varints.
+The byte array grows once per list; shrink_to_fit drops the slack at the end.
+*/
+CompressedGraph::CompressedGraph(const Graph& g) :
+    V(g.get_vertices()), E(g.get_edges()), directed(g.is_directed()), offset(V + 1, 0), fp(g.fingerprint())
+{
+    std::vector<std::pair<VertexId, int>> list;
+    for (int u = 0; u < V; ++u)
+    {
+        const auto& neighbors = g.get_neighbors(u);
+        const auto& weights = g.get_weights(u);
+        list.clear();
+        for (std::size_t i = 0; i < neighbors.size(); ++i)
+        {
+            list.push_back({static_cast<VertexId>(neighbors[i]), weights[i]});
+        }
+        std::stable_sort(list.begin(), list.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+        write_varint(bytes, static_cast<std::uint32_t>(list.size()));
+        VertexId prev = 0;
+        for (const auto& [v, w] : list)
+        {
+            write_varint(bytes, v - prev);
+            write_varint(bytes, static_cast<std::uint32_t>(w));
+            prev = v;
+        }
+        offset[u + 1] = bytes.size();
+    }
+    bytes.shrink_to_fit();
+}
+
+void CompressedGraph::Builder::begin(int vertices, bool isDirected, std::size_t)
+{
+    if (vertices <= 0)
+    {
+        throw std::invalid_argument("number of vertices must be positive");
+    }
+    V = vertices;
+    directed = isDirected;
+    E = 0;
+    lists.assign(static_cast<std::size_t>(V), {});
+    last.assign(static_cast<std::size_t>(V), 0);
+    count.assign(static_cast<std::size_t>(V), 0);
+    arcSum = {};
+}
+
+void CompressedGraph::Builder::add_arc(int u, int v, int w)
+{
+    if (count[u] > 0 && static_cast<VertexId>(v) < last[u])
+    {
+        throw std::invalid_argument("arcs of vertex " + std::to_string(u) + " arrive out of target order");
+    }
+    write_varint(lists[u], static_cast<VertexId>(v) - last[u]);
+    write_varint(lists[u], static_cast<std::uint32_t>(w));
+    last[u] = static_cast<VertexId>(v);
+    ++count[u];
+}
+
+void CompressedGraph::Builder::consume(const GraphEdge* edges, std::size_t n)
+{
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const GraphEdge& e = edges[i];
+        if (e.u < 0 || e.u >= V || e.v < 0 || e.v >= V)
+        {
+            throw std::out_of_range("Vertex index out of range");
+        }
+        if (e.w < 0)
+        {
+            throw std::invalid_argument("capacity must be non-negative");
+        }
+        GraphFingerprint h = graph_detail::arc_hash(e.u, e.v, e.w, directed);
+        add_arc(e.u, e.v, e.w);
+        graph_detail::add_hash(arcSum, h);
+        if (!directed)
+        {
+            add_arc(e.v, e.u, e.w);
+            graph_detail::add_hash(arcSum, h); // the reverse arc hashes the same
+        }
+        ++E;
+    }
+}
+
+/*
+Every list gets its degree in front and is appended to one exactly-sized byte array, then freed right away,
+so the graph is held about once while it is joined.
+*/
+CompressedGraph CompressedGraph::Builder::take()
+{
+    CompressedGraph g(V, E, directed);
+    g.offset.assign(static_cast<std::size_t>(V) + 1, 0);
+    std::size_t total = 0;
+    for (int u = 0; u < V; ++u)
+    {
+        total += lists[u].size() + 1;
+        for (std::uint32_t degree = count[u]; degree >= 0x80; degree >>= 7)
+        {
+            ++total; // longer degree varint
+        }
+    }
+    g.bytes.reserve(total);
+    for (int u = 0; u < V; ++u)
+    {
+        write_varint(g.bytes, count[u]);
+        g.bytes.insert(g.bytes.end(), lists[u].begin(), lists[u].end());
+        std::vector<std::uint8_t>().swap(lists[u]);
+        g.offset[u + 1] = g.bytes.size();
+    }
+    g.fp = graph_detail::shape_hash(arcSum, static_cast<std::uint64_t>(V), directed);
+
+    lists.clear();
+    last.clear();
+    count.clear();
+    E = 0;
+    arcSum = {};
+    return g;
+}
+
+void CompressedGraph::check_vertex(int u) const
+{
+    if (u < 0 || u >= V)
+    {
+        throw std::out_of_range("Vertex index out of range");
+    }
+}
+
+int CompressedGraph::degree(int u) const
+{
+    check_vertex(u);
+    const std::uint8_t* p = bytes.data() + offset[u];
+    return static_cast<int>(read_varint(p));
+}
+
+CompressedGraph::Range<CompressedGraph::ArcIterator> CompressedGraph::arcs(int u) const
+{
+    check_vertex(u);
+    const std::uint8_t* p = bytes.data() + offset[u];
+    std::uint32_t count = read_varint(p);
+    return {ArcIterator(p, count), ArcIterator(), count};
+}
+
+CompressedGraph::Range<CompressedGraph::NeighborIterator> CompressedGraph::get_neighbors(int u) const
+{
+    Range<ArcIterator> r = arcs(u);
+    return {NeighborIterator(r.first), NeighborIterator(r.last), r.count};
+}
+
+bool CompressedGraph::is_edge(int u, int v) const
+{
+    for (VertexId x : get_neighbors(u))
+    {
+        if (static_cast<int>(x) >= v)
+        {
+            return static_cast<int>(x) == v;
+        }
+    }
+    return false;
+}
+
+std::size_t CompressedGraph::memory_bytes() const
+{
+    return bytes.capacity() * sizeof(std::uint8_t) + offset.capacity() * sizeof(std::uint64_t);
+}
+
+// Print graph (for debugging), same format as Graph::print() (neighbors in sorted order)
+void CompressedGraph::print() const
+{
+    for (int u = 0; u < V; u++)
+    {
+        std::cout << u << ": ";
+        for (VertexId v : get_neighbors(u))
+        {
+            std::cout << v << " ";
+        }
+        std::cout << "\n";
+    }
+}
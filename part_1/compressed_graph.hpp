@@ -0,0 +1,207 @@
+/*
+@ author: Roy Meoded
+@ author: Yarin Keshet
+
+@ description: Immutable compressed adjacency storage for very large sparse graphs.
+                Every neighbor list is sorted and stored as a byte stream of LEB128 varints:
+                    degree, then for every arc: (target - previous target), weight
+                (the first delta is the target itself). Neighbors of a sparse graph are mostly close to each
+                other after sorting and unit weights are common, so a typical arc takes 2-3 bytes instead of the
+                8 bytes (+ two vectors per vertex) of Graph.
+                Lists are decoded on the fly by forward iterators: get_neighbors(u) for range-for traversals,
+                arcs(u) / for_each_arc(u, f) when the weights are needed too. Random access is not available,
+                so the part_7 algorithms have dedicated overloads that only walk lists front to back.
+                Neighbor order is by target (not insertion order); duplicates (parallel edges) are kept.
+                A CompressedGraph is either compressed from a Graph, or encoded by a Builder while a generator
+                streams the edges (edge_sink.hpp), so a large random graph is never built as a Graph (the generator
+                still holds its pair indices, or the whole list for the model families, while it streams).
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <iterator>
+
+#include "graph_impl.hpp"
+#include "edge_sink.hpp"
+
+class CompressedGraph
+{
+public:
+    using VertexId = std::uint32_t;
+
+    struct Arc
+    {
+        VertexId target;
+        int weight;
+    };
+
+    // Decodes one list: yields Arc values front to back
+    class ArcIterator
+    {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = Arc;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Arc*;
+        using reference = const Arc&;
+
+        ArcIterator() = default;
+        ArcIterator(const std::uint8_t* data, std::uint32_t count) : p(data), remaining(count) { decode(); }
+
+        const Arc& operator*() const { return current; }
+        const Arc* operator->() const { return &current; }
+        ArcIterator& operator++() { --remaining; decode(); return *this; }
+        bool operator==(const ArcIterator& other) const { return remaining == other.remaining; }
+        bool operator!=(const ArcIterator& other) const { return remaining != other.remaining; }
+
+    private:
+        const std::uint8_t* p = nullptr;
+        std::uint32_t remaining = 0;
+        Arc current{0, 0};
+
+        void decode()
+        {
+            if (remaining > 0)
+            {
+                current.target += read_varint(p);
+                current.weight = static_cast<int>(read_varint(p));
+            }
+        }
+    };
+
+    // Same stream, yields only the targets (what get_neighbors-style loops need)
+    class NeighborIterator
+    {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = VertexId;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const VertexId*;
+        using reference = VertexId;
+
+        NeighborIterator() = default;
+        explicit NeighborIterator(ArcIterator it) : arc(it) {}
+
+        VertexId operator*() const { return arc->target; }
+        NeighborIterator& operator++() { ++arc; return *this; }
+        bool operator==(const NeighborIterator& other) const { return arc == other.arc; }
+        bool operator!=(const NeighborIterator& other) const { return arc != other.arc; }
+
+    private:
+        ArcIterator arc;
+    };
+
+    template <typename It>
+    struct Range
+    {
+        It first;
+        It last;
+        std::uint32_t count;
+
+        It begin() const { return first; }
+        It end() const { return last; }
+        std::size_t size() const { return count; }
+        bool empty() const { return count == 0; }
+    };
+
+    // Compress an existing graph
+    explicit CompressedGraph(const Graph& g);
+
+    /*
+    Streaming construction: every arc is encoded as soon as its edge arrives, into a byte list of its own
+    vertex, and take() joins the lists (the result equals compressing the Graph of the same edges).
+    The arcs of every vertex must arrive in non-decreasing target order, the reverse arcs of undirected edges
+    included: the builder asks the generators for a (u, v)-sorted stream (needs_sorted()).
+    Throws like addEdge for a bad endpoint or a negative weight, invalid_argument for an arc out of order.
+    */
+    class Builder : public EdgeSink
+    {
+    public:
+        void begin(int vertices, bool directed, std::size_t edges) override;
+        void consume(const GraphEdge* edges, std::size_t count) override;
+        bool needs_sorted() const override { return true; }
+
+        // The finished graph (the builder is left empty)
+        CompressedGraph take();
+
+    private:
+        int V = 0;
+        bool directed = false;
+        std::size_t E = 0;
+        std::vector<std::vector<std::uint8_t>> lists; // (target delta, weight) varints of every vertex
+        std::vector<VertexId> last;                   // last target added to every list
+        std::vector<std::uint32_t> count;             // arcs in every list
+        GraphFingerprint arcSum;
+
+        void add_arc(int u, int v, int w);
+    };
+
+    int get_vertices() const { return V; }
+    std::size_t get_edges() const { return E; }
+    bool is_directed() const { return directed; }
+
+    // Number of stored arcs leaving u
+    int degree(int u) const;
+
+    // Decoding ranges over the arcs / neighbors of u (sorted by target)
+    Range<ArcIterator> arcs(int u) const;
+    Range<NeighborIterator> get_neighbors(int u) const;
+
+    // f(target, weight) for every arc leaving u
+    template <typename F>
+    void for_each_arc(int u, F&& f) const
+    {
+        for (const Arc& a : arcs(u))
+        {
+            f(a.target, a.weight);
+        }
+    }
+
+    // Returns true if there is an edge from u to v (stops as soon as the sorted list passes v)
+    bool is_edge(int u, int v) const;
+
+    // Fingerprint of the graph it was compressed from (same content, same value)
+    GraphFingerprint fingerprint() const { return fp; }
+
+    // Bytes used by the compressed lists and their offsets
+    std::size_t memory_bytes() const;
+
+    // Print graph (for debugging)
+    void print() const;
+
+    // LEB128: 7 bits per byte, high bit set on every byte except the last
+    static void write_varint(std::vector<std::uint8_t>& out, std::uint32_t value);
+    static std::uint32_t read_varint(const std::uint8_t*& p)
+    {
+        std::uint32_t value = *p++;
+        if (value < 0x80)
+        {
+            return value; // fast path: one byte
+        }
+        value &= 0x7f;
+        for (int shift = 7; ; shift += 7)
+        {
+            std::uint32_t byte = *p++;
+            value |= (byte & 0x7f) << shift;
+            if (byte < 0x80)
+            {
+                return value;
+            }
+        }
+    }
+
+private:
+    int V;
+    std::size_t E;
+    bool directed;
+    std::vector<std::uint64_t> offset; // byte offset of the list of every vertex, size V+1
+    std::vector<std::uint8_t> bytes;   // all encoded lists
+    GraphFingerprint fp;
+
+    CompressedGraph(int vertices, std::size_t edges, bool isDirected) : V(vertices), E(edges), directed(isDirected) {}
+
+    void check_vertex(int u) const;
+};
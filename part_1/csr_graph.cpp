@@ -0,0 +1,135 @@
+#include "csr_graph.hpp"
+
+/*
+Freeze a Graph into CSR form:
+1. offset[u+1] = offset[u] + degree(u) (prefix sum over the adjacency list sizes).
+2. Copy every neighbor list (and its weights) into the contiguous arrays in the same order.
+*/
+CsrGraph::CsrGraph(const Graph& g) :
+    V(g.get_vertices()), E(g.get_edges()), directed(g.is_directed()), offset(V + 1, 0)
+{
+    const auto& adj = g.getAdjList();
+    const auto& wts = g.getWeightList();
+    for (int u = 0; u < V; ++u)
+    {
+        offset[u + 1] = offset[u] + adj[u].size();
+    }
+    target.resize(offset[V]);
+    weight.resize(offset[V]);
+    for (int u = 0; u < V; ++u)
+    {
+        std::copy(adj[u].begin(), adj[u].end(), target.begin() + offset[u]);
+        std::copy(wts[u].begin(), wts[u].end(), weight.begin() + offset[u]);
+    }
+}
+
+/*
+Two-pass bulk build from an edge list:
+1. Validate every edge and count the out-degree of each vertex (both endpoints for undirected graphs).
+2. Prefix sum the degrees into offset[].
+3. Scatter the edges into their slots using a per-vertex cursor, so the input order is kept
+(the same order Graph::addEdge would have produced).
+*/
+CsrGraph::CsrGraph(int vertices, bool isDirected, const std::vector<GraphEdge>& edges) :
+    V(vertices), E(0), directed(isDirected)
+{
+    if (vertices <= 0)
+    {
+        throw std::invalid_argument("number of vertices must be positive");
+    }
+    offset.assign(V + 1, 0);
+
+    // 1) validate + degree count (counts are stored shifted by one to prefix-sum in place)
+    for (const auto& e : edges)
+    {
+        if (e.u < 0 || e.u >= V || e.v < 0 || e.v >= V)
+        {
+            throw std::out_of_range("Vertex index out of range");
+        }
+        if (e.w < 0)
+        {
+            throw std::invalid_argument("capacity must be non-negative");
+        }
+        ++offset[e.u + 1];
+        if (!directed)
+        {
+            ++offset[e.v + 1];
+        }
+    }
+
+    // 2) prefix sum
+    for (int u = 0; u < V; ++u)
+    {
+        offset[u + 1] += offset[u];
+    }
+
+    // 3) scatter
+    target.resize(offset[V]);
+    weight.resize(offset[V]);
+    std::vector<std::uint64_t> cursor(offset.begin(), offset.end() - 1);
+    for (const auto& e : edges)
+    {
+        std::uint64_t a = cursor[e.u]++;
+        target[a] = static_cast<VertexId>(e.v);
+        weight[a] = e.w;
+        if (!directed)
+        {
+            std::uint64_t b = cursor[e.v]++;
+            target[b] = static_cast<VertexId>(e.u);
+            weight[b] = e.w;
+        }
+    }
+    E = static_cast<int>(edges.size());
+}
+
+void CsrGraph::check_vertex(int u) const
+{
+    if (u < 0 || u >= V)
+    {
+        throw std::out_of_range("Vertex index out of range");
+    }
+}
+
+int CsrGraph::degree(int u) const
+{
+    check_vertex(u);
+    return static_cast<int>(offset[u + 1] - offset[u]);
+}
+
+CsrGraph::Slice<CsrGraph::VertexId> CsrGraph::get_neighbors(int u) const
+{
+    check_vertex(u);
+    return {target.data() + offset[u], target.data() + offset[u + 1]};
+}
+
+CsrGraph::Slice<int> CsrGraph::get_weights(int u) const
+{
+    check_vertex(u);
+    return {weight.data() + offset[u], weight.data() + offset[u + 1]};
+}
+
+bool CsrGraph::is_edge(int u, int v) const
+{
+    for (VertexId x : get_neighbors(u))
+    {
+        if (static_cast<int>(x) == v)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Print graph (for debugging), same format as Graph::print()
+void CsrGraph::print() const
+{
+    for (int u = 0; u < V; u++)
+    {
+        std::cout << u << ": ";
+        for (VertexId v : get_neighbors(u))
+        {
+            std::cout << v << " ";
+        }
+        std::cout << "\n";
+    }
+}
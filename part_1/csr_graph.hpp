@@ -0,0 +1,95 @@
+/*
+@ author: Roy Meoded
+@ author: Yarin Keshet
+
+@ description: Immutable compressed-sparse-row (CSR) graph.
+                All neighbor lists live in one contiguous array (32-bit vertex ids) with a parallel
+                weight array, and offset[u]..offset[u+1] is the slice that belongs to vertex u.
+                A CsrGraph is either frozen from an existing Graph, or bulk-built from an edge list in two
+                passes (degree count + prefix sum, then scatter), without any per-vertex heap allocation.
+                The accessors mirror Graph (get_vertices, get_neighbors, get_weights, is_edge...),
+                so the algorithms in part_7 can run on both representations.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <stdexcept>
+
+#include "graph_impl.hpp"
+
+class CsrGraph
+{
+public:
+    using VertexId = std::uint32_t;
+
+    // Read-only view over a contiguous part of one of the CSR arrays (like a small std::span):
+    template <typename T>
+    struct Slice
+    {
+        const T* first;
+        const T* last;
+
+        const T* begin() const { return first; }
+        const T* end() const { return last; }
+        std::size_t size() const { return static_cast<std::size_t>(last - first); }
+        bool empty() const { return first == last; }
+        const T& operator[](std::size_t i) const { return first[i]; }
+    };
+
+    // Freeze an existing Graph (neighbor order of every vertex is preserved)
+    explicit CsrGraph(const Graph& g);
+
+    // Bulk-build from an edge list (for undirected graphs every edge is stored in both directions)
+    CsrGraph(int vertices, bool isDirected, const std::vector<GraphEdge>& edges);
+
+    // Get number of vertices
+    int get_vertices() const { return V; }
+
+    // Get number of edges (as added, an undirected edge counts once)
+    int get_edges() const { return E; }
+
+    bool is_directed() const { return directed; }
+
+    // Number of stored arcs leaving u
+    int degree(int u) const;
+
+    // Neighbors / capacities of u (parallel slices)
+    Slice<VertexId> get_neighbors(int u) const;
+    Slice<int> get_weights(int u) const;
+
+    // f(target, weight) for every arc leaving u
+    template <typename F>
+    void for_each_arc(int u, F&& f) const
+    {
+        Slice<VertexId> neighbors = get_neighbors(u);
+        Slice<int> capacities = get_weights(u);
+        for (std::size_t i = 0; i < neighbors.size(); ++i)
+        {
+            f(neighbors[i], capacities[i]);
+        }
+    }
+
+    // Returns true if there is an edge from u to v
+    bool is_edge(int u, int v) const;
+
+    // Raw CSR arrays
+    const std::vector<std::uint64_t>& get_offsets() const { return offset; }
+    const std::vector<VertexId>& get_targets() const { return target; }
+    const std::vector<int>& get_weight_array() const { return weight; }
+
+    // Print graph (for debugging)
+    void print() const;
+
+private:
+    int V;  // number of vertices
+    int E;  // number of edges
+    bool directed;
+    std::vector<std::uint64_t> offset; // size V+1, arcs of u are [offset[u], offset[u+1])
+    std::vector<VertexId> target;      // target[a] = head vertex of arc a
+    std::vector<int> weight;           // weight[a] = capacity of arc a
+
+    void check_vertex(int u) const;
+};
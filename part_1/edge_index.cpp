@@ -0,0 +1,160 @@
+#include "edge_index.hpp"
+
+#include <algorithm>
+
+// Bit matrices above this size are never used (V ~ 23000)
+static constexpr std::size_t kMaxBitMatrixBytes = std::size_t(64) << 20;
+// Bit matrices up to this size are always used, lookups are a single memory access
+static constexpr std::size_t kSmallBitMatrixBytes = std::size_t(4) << 20;
+// Neighbor lists up to this length are searched linearly
+static constexpr std::size_t kLinearSearchMax = 16;
+
+/*
+Mode selection:
+*BIT_MATRIX costs V*V/8 bytes no matter how many edges there are.
+*SORTED_LISTS costs 4 bytes per arc + 8 bytes per vertex.
+Use the bit matrix when it is small anyway, or when it is not much larger than the sorted lists
+(dense graphs), as long as it stays under a hard cap.
+*/
+EdgeIndex::Mode EdgeIndex::choose_mode(int vertices, std::size_t arcs)
+{
+    std::size_t n = static_cast<std::size_t>(vertices);
+    std::size_t matrixBytes = n * ((n + 63) / 64) * sizeof(std::uint64_t);
+    std::size_t listBytes = arcs * sizeof(std::uint32_t) + (n + 1) * sizeof(std::uint64_t);
+    if (matrixBytes > kMaxBitMatrixBytes)
+    {
+        return Mode::SORTED_LISTS;
+    }
+    if (matrixBytes <= kSmallBitMatrixBytes || matrixBytes <= 2 * listBytes)
+    {
+        return Mode::BIT_MATRIX;
+    }
+    return Mode::SORTED_LISTS;
+}
+
+template <typename NeighborsOf>
+void EdgeIndex::build(int vertices, std::size_t arcs, NeighborsOf neighborsOf)
+{
+    clear();
+    V = vertices;
+    mode_ = choose_mode(vertices, arcs);
+    if (mode_ == Mode::BIT_MATRIX)
+    {
+        rowWords = (static_cast<std::size_t>(V) + 63) / 64;
+        bits.assign(rowWords * V, 0);
+        for (int u = 0; u < V; ++u)
+        {
+            for (auto v : neighborsOf(u))
+            {
+                insert(u, static_cast<int>(v));
+            }
+        }
+        return;
+    }
+
+    // SORTED_LISTS: copy every list into CSR form, then sort each slice
+    offsets.assign(V + 1, 0);
+    targets.reserve(arcs);
+    for (int u = 0; u < V; ++u)
+    {
+        for (auto v : neighborsOf(u))
+        {
+            targets.push_back(static_cast<std::uint32_t>(v));
+        }
+        offsets[u + 1] = targets.size();
+        std::sort(targets.begin() + offsets[u], targets.end());
+    }
+}
+
+template <typename VertexT>
+EdgeIndex::EdgeIndex(int vertices, const std::pmr::vector<std::pmr::vector<VertexT>>& adj)
+{
+    std::size_t arcs = 0;
+    for (const auto& list : adj)
+    {
+        arcs += list.size();
+    }
+    build(vertices, arcs, [&](int u) -> const std::pmr::vector<VertexT>& { return adj[u]; });
+}
+
+template EdgeIndex::EdgeIndex(int, const std::pmr::vector<std::pmr::vector<int>>&);
+template EdgeIndex::EdgeIndex(int, const std::pmr::vector<std::pmr::vector<std::uint32_t>>&);
+template EdgeIndex::EdgeIndex(int, const std::pmr::vector<std::pmr::vector<std::uint64_t>>&);
+
+// Small range over one CSR slice, so build() can iterate it like a vector
+namespace
+{
+    struct TargetRange
+    {
+        const std::uint32_t* first;
+        const std::uint32_t* last;
+        const std::uint32_t* begin() const { return first; }
+        const std::uint32_t* end() const { return last; }
+    };
+}
+
+EdgeIndex::EdgeIndex(int vertices, const std::uint64_t* csrOffsets, const std::uint32_t* csrTargets)
+{
+    build(vertices, csrOffsets[vertices], [&](int u)
+    {
+        return TargetRange{csrTargets + csrOffsets[u], csrTargets + csrOffsets[u + 1]};
+    });
+}
+
+bool EdgeIndex::contains(int u, int v) const
+{
+    if (mode_ == Mode::BIT_MATRIX)
+    {
+        const std::uint64_t word = bits[static_cast<std::size_t>(u) * rowWords + (static_cast<std::size_t>(v) >> 6)];
+        return (word >> (v & 63)) & 1u;
+    }
+    if (mode_ == Mode::SORTED_LISTS)
+    {
+        auto first = targets.begin() + offsets[u];
+        auto last = targets.begin() + offsets[u + 1];
+        std::uint32_t key = static_cast<std::uint32_t>(v);
+        if (static_cast<std::size_t>(last - first) <= kLinearSearchMax)
+        {
+            return std::find(first, last, key) != last;
+        }
+        return std::binary_search(first, last, key);
+    }
+    return false;
+}
+
+bool EdgeIndex::insert(int u, int v)
+{
+    if (mode_ != Mode::BIT_MATRIX)
+    {
+        return false;
+    }
+    bits[static_cast<std::size_t>(u) * rowWords + (static_cast<std::size_t>(v) >> 6)] |= std::uint64_t(1) << (v & 63);
+    return true;
+}
+
+bool EdgeIndex::erase(int u, int v)
+{
+    if (mode_ != Mode::BIT_MATRIX)
+    {
+        return false;
+    }
+    bits[static_cast<std::size_t>(u) * rowWords + (static_cast<std::size_t>(v) >> 6)] &= ~(std::uint64_t(1) << (v & 63));
+    return true;
+}
+
+void EdgeIndex::clear()
+{
+    mode_ = Mode::NONE;
+    V = 0;
+    rowWords = 0;
+    std::vector<std::uint64_t>().swap(bits);
+    std::vector<std::uint64_t>().swap(offsets);
+    std::vector<std::uint32_t>().swap(targets);
+}
+
+std::size_t EdgeIndex::memory_bytes() const
+{
+    return bits.capacity() * sizeof(std::uint64_t)
+         + offsets.capacity() * sizeof(std::uint64_t)
+         + targets.capacity() * sizeof(std::uint32_t);
+}
@@ -0,0 +1,78 @@
+/*
+@ author: Roy Meoded
+@ author: Yarin Keshet
+
+@ description: Adaptive edge-existence index, used to answer is_edge(u, v) without scanning neighbor lists.
+                Two layouts, picked automatically from V and the number of stored arcs:
+                - BIT_MATRIX: packed VxV bit matrix (one bit per pair), O(1) lookups. Used for small/dense graphs,
+                  where V*V/8 bytes is cheap compared to the neighbor lists themselves.
+                - SORTED_LISTS: CSR copy of the neighbor lists with each list sorted, lookups by binary search
+                  (short lists are scanned linearly, they fit in one cache line). Used for large sparse graphs.
+                The index is a snapshot: it is built from an adjacency structure and does not follow later changes
+                (Graph keeps its own copy up to date, see Graph::build_edge_index()).
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <memory_resource>
+
+class EdgeIndex
+{
+public:
+    enum class Mode
+    {
+        NONE,          // not built
+        BIT_MATRIX,    // packed VxV bits
+        SORTED_LISTS   // sorted CSR neighbor lists
+    };
+
+    // Empty index (ready() == false)
+    EdgeIndex() = default;
+
+    // Build from adjacency lists (Graph layout; VertexT is int, uint32_t or uint64_t)
+    template <typename VertexT>
+    EdgeIndex(int vertices, const std::pmr::vector<std::pmr::vector<VertexT>>& adj);
+
+    // Build from CSR arrays (CsrGraph / MappedGraph layout): offsets has vertices+1 entries
+    EdgeIndex(int vertices, const std::uint64_t* offsets, const std::uint32_t* targets);
+
+    // Which layout should be used for a graph with this many vertices and stored arcs
+    static Mode choose_mode(int vertices, std::size_t arcs);
+
+    bool ready() const { return mode_ != Mode::NONE; }
+    Mode mode() const { return mode_; }
+
+    // Returns true if the arc u->v was indexed (u, v must be valid vertex ids)
+    bool contains(int u, int v) const;
+
+    // Record a new arc u->v. Only possible in BIT_MATRIX mode (returns false otherwise, the caller
+    // must then rebuild or drop the index).
+    bool insert(int u, int v);
+
+    // Forget the arc u->v (the last parallel copy was removed). Same restriction as insert().
+    bool erase(int u, int v);
+
+    // Drop the index and release its memory
+    void clear();
+
+    // Bytes used by the index
+    std::size_t memory_bytes() const;
+
+private:
+    Mode mode_ = Mode::NONE;
+    int V = 0;
+
+    // BIT_MATRIX: row u occupies words [u*rowWords, (u+1)*rowWords)
+    std::size_t rowWords = 0;
+    std::vector<std::uint64_t> bits;
+
+    // SORTED_LISTS: arcs of u are sorted in targets[offsets[u] .. offsets[u+1])
+    std::vector<std::uint64_t> offsets;
+    std::vector<std::uint32_t> targets;
+
+    template <typename NeighborsOf>
+    void build(int vertices, std::size_t arcs, NeighborsOf neighborsOf);
+};
@@ -0,0 +1,407 @@
+/*
+@ author: Roy Meoded
+@ author: Yarin Keshet
+
+@ description: Uniform random edge sets without a set of used pairs, for the random graph generators
+                (part_3/random_graph.cpp, part_8/include/random_graph.cpp).
+The N candidate pairs of a simple graph (no self-loops) are numbered 0..N-1 in (u, v) order, so an edge set
+is a set of indices:
+- G(n,p): every index is taken independently with probability p, jumping from one taken index to the next
+  with a geometric skip (Batagelj & Brandes), O(V + E).
+- G(n,m): exactly m indices, uniformly among all m-subsets: a G(n,p) draw with p slightly above m/N has at
+  least m indices with high probability (redrawn otherwise) and the surplus is dropped uniformly, O(V + E)
+  expected. For m > N/2 the N - m missing pairs are drawn instead.
+Indices come out sorted, so the edges are sorted by (u, v) and are decoded by walking the rows once.
+All draws go through explicit formulas (no std:: distributions, whose output differs between standard
+libraries), so a seed gives the same edges everywhere.
+The parallel versions cut the index range into blocks fixed by (N, expected edges) alone and draw every block
+from its own Philox stream (philox.hpp): threads take whole blocks, so the edges do not depend on the number
+of threads.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "philox.hpp"
+#include "thread_utils.hpp"
+
+/*
+Versions of the random graph generators. A seed gives the same graph under the same version for as long as
+that version exists: a new algorithm gets a new number instead of changing an old one.
+- Rejection (1): the original generator, pairs drawn with std::mt19937 and rejected when already used
+  (a red-black tree of used pairs; slow as E approaches the number of pairs).
+- Sampled (2): the samplers of this file on one std::mt19937_64.
+- Parallel (3): the same samplers over blocks of Philox streams, drawn on several threads; the graph depends
+  on the seed only, not on the thread count.
+*/
+enum class GeneratorVersion
+{
+    Rejection = 1,
+    Sampled = 2,
+    Parallel = 3,
+    Latest = Parallel
+};
+
+// Version from its number (the part_4 CLI, the GENERATOR protocol key); throws invalid_argument otherwise
+inline GeneratorVersion generator_version(int number)
+{
+    if (number < static_cast<int>(GeneratorVersion::Rejection) || number > static_cast<int>(GeneratorVersion::Latest))
+    {
+        throw std::invalid_argument("unknown generator version " + std::to_string(number));
+    }
+    return static_cast<GeneratorVersion>(number);
+}
+
+// Number of vertex pairs of a simple graph: V(V-1)/2 undirected, V(V-1) directed
+inline std::uint64_t pair_count(int vertices, bool directed)
+{
+    std::uint64_t V = vertices > 0 ? static_cast<std::uint64_t>(vertices) : 0;
+    return V < 2 ? 0 : (directed ? V * (V - 1) : V * (V - 1) / 2);
+}
+
+// Uniform double in (0, 1): the top 53 bits of one 64-bit draw, centered in their interval
+template <typename Rng>
+double open_unit(Rng& rng)
+{
+    return (static_cast<double>(rng() >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+}
+
+// Uniform integer in [0, bound), bound > 0 (Lemire's multiply-shift with rejection: exact, usually one draw)
+template <typename Rng>
+std::uint64_t uniform_below(std::uint64_t bound, Rng& rng)
+{
+    unsigned __int128 product = static_cast<unsigned __int128>(rng()) * bound;
+    std::uint64_t low = static_cast<std::uint64_t>(product);
+    if (low < bound)
+    {
+        std::uint64_t threshold = (0 - bound) % bound;
+        while (low < threshold)
+        {
+            product = static_cast<unsigned __int128>(rng()) * bound;
+            low = static_cast<std::uint64_t>(product);
+        }
+    }
+    return static_cast<std::uint64_t>(product >> 64);
+}
+
+// Calls take(i), in increasing order, for every i in [0, n) taken independently with probability p
+template <typename Rng, typename F>
+void bernoulli_indices(std::uint64_t n, double p, Rng& rng, F take)
+{
+    if (p <= 0.0 || n == 0)
+    {
+        return;
+    }
+    if (p >= 1.0)
+    {
+        for (std::uint64_t i = 0; i < n; ++i)
+        {
+            take(i);
+        }
+        return;
+    }
+    // The gap before the next taken index is geometric: floor(log U / log(1 - p))
+    const double log_q = std::log1p(-p);
+    std::uint64_t i = 0;
+    while (true)
+    {
+        double skip = std::floor(std::log(open_unit(rng)) / log_q);
+        if (skip >= static_cast<double>(n - i))
+        {
+            return;
+        }
+        i += static_cast<std::uint64_t>(skip);
+        take(i);
+        if (++i == n)
+        {
+            return;
+        }
+    }
+}
+
+// Probability of the oversampling draw for m of n indices (m <= n / 2): a few standard deviations above m / n
+inline double oversampling_rate(std::uint64_t n, std::uint64_t m)
+{
+    const double mean = static_cast<double>(m);
+    return std::min(1.0, (mean + 3.0 * std::sqrt(mean) + 10.0) / static_cast<double>(n));
+}
+
+/*
+Thins a sorted index set down to m indices by dropping a uniform subset of the surplus (mostly O(sqrt m) of
+them), keeping the order. Conditioned on its size, a Bernoulli draw is a uniform subset, so the result is a
+uniform m-subset.
+*/
+template <typename Rng>
+void drop_surplus(std::vector<std::uint64_t>& picked, std::uint64_t m, Rng& rng)
+{
+    std::uint64_t surplus = picked.size() - m;
+    std::vector<char> dropped(picked.size(), 0);
+    while (surplus > 0)
+    {
+        std::uint64_t i = uniform_below(picked.size(), rng);
+        if (!dropped[i])
+        {
+            dropped[i] = 1;
+            --surplus;
+        }
+    }
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < picked.size(); ++i)
+    {
+        if (!dropped[i])
+        {
+            picked[kept++] = picked[i];
+        }
+    }
+    picked.resize(kept);
+}
+
+// The indices of [0, n) not in the sorted set `missing`, written by `threads` threads over contiguous ranges
+inline std::vector<std::uint64_t> complement_indices(std::uint64_t n, const std::vector<std::uint64_t>& missing,
+                                                     unsigned threads)
+{
+    std::vector<std::uint64_t> picked(n - missing.size());
+    threads = static_cast<unsigned>(std::max<std::uint64_t>(1, std::min<std::uint64_t>(threads, n)));
+    // Part t starts at its first index minus the missing ones before it
+    std::vector<std::size_t> skipped(threads);
+    for (unsigned t = 0; t < threads; ++t)
+    {
+        std::uint64_t first = part_range(n, threads, t).first;
+        skipped[t] = static_cast<std::size_t>(std::lower_bound(missing.begin(), missing.end(), first) - missing.begin());
+    }
+    run_on_threads(threads, [&](unsigned t)
+    {
+        auto [first, last] = part_range(n, threads, t);
+        std::size_t next = skipped[t];
+        std::size_t out = static_cast<std::size_t>(first) - next;
+        for (std::uint64_t i = first; i < last; ++i)
+        {
+            if (next < missing.size() && missing[next] == i)
+            {
+                ++next;
+            }
+            else
+            {
+                picked[out++] = i;
+            }
+        }
+    });
+    return picked;
+}
+
+// m distinct indices of [0, n), uniformly among all m-subsets, sorted; O(m + 1) expected for m <= n / 2
+inline std::vector<std::uint64_t> sample_indices(std::uint64_t n, std::uint64_t m, std::mt19937_64& rng)
+{
+    if (m > n)
+    {
+        throw std::invalid_argument("cannot sample more indices than there are");
+    }
+    std::vector<std::uint64_t> picked;
+    if (m == 0)
+    {
+        return picked;
+    }
+    if (m > n / 2)
+    {
+        // Dense: draw the n - m indices that are left out and emit the others
+        return complement_indices(n, sample_indices(n, n - m, rng), 1);
+    }
+
+    // Every index independently with p slightly above m / n: a short draw is simply repeated (rare), a long one
+    // thinned out
+    const double p = oversampling_rate(n, m);
+    picked.reserve(static_cast<std::size_t>(p * static_cast<double>(n) * 1.05) + 16);
+    do
+    {
+        picked.clear();
+        bernoulli_indices(n, p, rng, [&](std::uint64_t i) { picked.push_back(i); });
+    } while (picked.size() < m);
+    drop_surplus(picked, m, rng);
+    return picked;
+}
+
+// Philox streams of the parallel samplers: index draws use (round << 32 | block), these two lie above them
+constexpr std::uint64_t THINNING_STREAM = ~std::uint64_t(0);    // drop_surplus of parallel_sample_indices
+constexpr std::uint64_t WEIGHT_STREAM = ~std::uint64_t(0) - 1;  // edge weights, block position = pair index
+
+// Blocks of the parallel samplers: about 65536 expected indices each (at most 65536 blocks, at most n)
+inline unsigned sample_blocks(std::uint64_t n, double expected)
+{
+    double blocks = std::min(65536.0, std::ceil(expected / 65536.0));
+    return static_cast<unsigned>(std::max<std::uint64_t>(1, std::min<std::uint64_t>(n, static_cast<std::uint64_t>(blocks))));
+}
+
+// Threads for `blocks` blocks: threads = 0 means one per core
+inline unsigned sample_threads(unsigned threads, unsigned blocks)
+{
+    unsigned T = threads ? threads : std::max(1u, std::thread::hardware_concurrency());
+    return std::max(1u, std::min(T, blocks));
+}
+
+/*
+G(n,p) indices, sorted, drawn block by block on several threads: block k of [0, n) comes from Philox stream
+(round << 32 | k) and every thread draws whole blocks, so the result depends on (n, p, seed, round) only.
+*/
+inline std::vector<std::uint64_t> parallel_bernoulli_indices(std::uint64_t n, double p, std::uint64_t seed,
+                                                             unsigned threads, std::uint32_t round = 0)
+{
+    const unsigned blocks = sample_blocks(n, std::max(0.0, std::min(p, 1.0)) * static_cast<double>(n));
+    const unsigned T = sample_threads(threads, blocks);
+    std::vector<std::vector<std::uint64_t>> parts(T);
+    run_on_threads(T, [&](unsigned t)
+    {
+        auto [first_block, last_block] = part_range(blocks, T, t);
+        for (std::size_t k = first_block; k < last_block; ++k)
+        {
+            auto [first, last] = part_range(n, blocks, static_cast<unsigned>(k));
+            PhiloxStream rng(seed, (static_cast<std::uint64_t>(round) << 32) | k);
+            bernoulli_indices(last - first, p, rng, [&](std::uint64_t i) { parts[t].push_back(first + i); });
+        }
+    });
+
+    // Concatenate the parts in thread (= block) order
+    std::vector<std::size_t> offset(T + 1, 0);
+    for (unsigned t = 0; t < T; ++t)
+    {
+        offset[t + 1] = offset[t] + parts[t].size();
+    }
+    std::vector<std::uint64_t> picked(offset[T]);
+    run_on_threads(T, [&](unsigned t)
+    {
+        std::copy(parts[t].begin(), parts[t].end(), picked.begin() + static_cast<std::ptrdiff_t>(offset[t]));
+        std::vector<std::uint64_t>().swap(parts[t]);
+    });
+    return picked;
+}
+
+// sample_indices on several threads: same distribution, the result depends on (n, m, seed) only
+inline std::vector<std::uint64_t> parallel_sample_indices(std::uint64_t n, std::uint64_t m, std::uint64_t seed,
+                                                          unsigned threads)
+{
+    if (m > n)
+    {
+        throw std::invalid_argument("cannot sample more indices than there are");
+    }
+    if (m == 0)
+    {
+        return {};
+    }
+    if (m > n / 2)
+    {
+        return complement_indices(n, parallel_sample_indices(n, n - m, seed, threads),
+                                  sample_threads(threads, sample_blocks(n, static_cast<double>(n))));
+    }
+    const double p = oversampling_rate(n, m);
+    std::vector<std::uint64_t> picked;
+    std::uint32_t round = 0;
+    do
+    {
+        picked = parallel_bernoulli_indices(n, p, seed, threads, round++);
+    } while (picked.size() < m);
+    PhiloxStream rng(seed, THINNING_STREAM);
+    drop_surplus(picked, m, rng);
+    return picked;
+}
+
+/*
+(u, v) of pair indices given in non-decreasing order, O(V + calls) in total.
+Undirected: the pairs u < v, row u holds v = u+1..V-1. Directed: row u holds every v != u.
+*/
+class PairDecoder
+{
+public:
+    // first: the smallest index that will be decoded (the row walk starts there)
+    PairDecoder(int vertices, bool directed, std::uint64_t first = 0)
+        : V(vertices), directed(directed), row_size(static_cast<std::uint64_t>(vertices - 1))
+    {
+        if (first > 0 && vertices > 1)
+        {
+            seek(first);
+        }
+    }
+
+    std::pair<int, int> operator()(std::uint64_t index)
+    {
+        while (index >= row_first + row_size)
+        {
+            row_first += row_size;
+            ++u;
+            row_size = directed ? static_cast<std::uint64_t>(V - 1) : static_cast<std::uint64_t>(V - 1 - u);
+        }
+        int c = static_cast<int>(index - row_first);
+        int v = directed ? (c < u ? c : c + 1) : u + 1 + c;
+        return {u, v};
+    }
+
+private:
+    // Jumps to the row of index: directed rows all have V-1 pairs; undirected row u starts at u(2V-u-1)/2
+    void seek(std::uint64_t index)
+    {
+        const std::uint64_t width = static_cast<std::uint64_t>(V - 1);
+        if (directed)
+        {
+            u = static_cast<int>(index / width);
+            row_first = static_cast<std::uint64_t>(u) * width;
+            return;
+        }
+        auto start = [&](std::uint64_t r) { return r * (2 * static_cast<std::uint64_t>(V) - r - 1) / 2; };
+        long double b = 2.0L * V - 1;
+        long double guess = (b - std::sqrt(std::max(0.0L, b * b - 8.0L * static_cast<long double>(index)))) / 2;
+        std::uint64_t r = static_cast<std::uint64_t>(std::max(0.0L, std::min(guess, static_cast<long double>(V - 2))));
+        while (r > 0 && start(r) > index)
+        {
+            --r;
+        }
+        while (r + 2 < static_cast<std::uint64_t>(V) && start(r + 1) <= index)
+        {
+            ++r;
+        }
+        u = static_cast<int>(r);
+        row_first = start(r);
+        row_size = width - r;
+    }
+
+    int V;
+    bool directed;
+    int u = 0;
+    std::uint64_t row_first = 0;
+    std::uint64_t row_size;
+};
+
+/*
+Decodes sorted pair indices[0..count) on several threads: emit(i, u, v) for every i, from the thread owning
+position i (each thread starts its own PairDecoder at its first index).
+*/
+template <typename F>
+void parallel_decode(const std::uint64_t* indices, std::size_t count, int vertices, bool directed, unsigned threads, F emit)
+{
+    const unsigned T = sample_threads(threads, sample_blocks(count, static_cast<double>(count)));
+    run_on_threads(T, [&](unsigned t)
+    {
+        auto [first, last] = part_range(count, T, t);
+        if (first == last)
+        {
+            return;
+        }
+        PairDecoder pair(vertices, directed, indices[first]);
+        for (std::size_t i = first; i < last; ++i)
+        {
+            auto [u, v] = pair(indices[i]);
+            emit(i, u, v);
+        }
+    });
+}
+
+template <typename F>
+void parallel_decode(const std::vector<std::uint64_t>& indices, int vertices, bool directed, unsigned threads, F emit)
+{
+    parallel_decode(indices.data(), indices.size(), vertices, directed, threads, emit);
+}
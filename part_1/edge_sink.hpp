@@ -0,0 +1,61 @@
+/*
+@ author: Roy Meoded
+@ author: Yarin Keshet
+
+@ description: Destination of a streamed edge list.
+                A generator (generate_random_edges / generate_model_edges of part_8) hands its edges over in
+                batches instead of returning a list or a Graph, so the consumer only ever builds its own form:
+                - EdgeListSink: a plain edge list (what build_graph_parallel takes),
+                - CompressedGraph::Builder (compressed_graph.hpp): varint lists encoded while the edges arrive,
+                - the PREVIEW writers of the part_8/part_9 servers: text lines appended to the response body,
+                - or an algorithm that only needs to see every edge once.
+                Generators deliver every pair once. The sampled versions always deliver them sorted by (u, v),
+                undirected edges with u < v; the original generator (Rejection) and the model families deliver
+                them in draw order, as drawn, unless the sink asks for sorted input (needs_sorted()).
+                Streaming saves the consumer's copy only: the sampled versions still hold their sorted pair indices
+                (8 bytes per edge), and Rejection and the model families their whole edge list, while they stream.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "graph_impl.hpp"
+
+class EdgeSink
+{
+public:
+    virtual ~EdgeSink() = default;
+
+    // Called once before the first batch: vertex count, orientation and the exact number of edges that follow
+    virtual void begin(int vertices, bool directed, std::size_t edges) = 0;
+
+    // The next edges[0..count) of the stream (the array is only valid during the call)
+    virtual void consume(const GraphEdge* edges, std::size_t count) = 0;
+
+    // Called once after the last batch
+    virtual void finish() {}
+
+    // True if the edges must arrive sorted by (u, v), undirected ones with u < v (the generators that draw in
+    // another order sort for such a sink only, so a Graph built from the stream keeps the draw order)
+    virtual bool needs_sorted() const { return false; }
+};
+
+// Collects the stream into a list
+class EdgeListSink : public EdgeSink
+{
+public:
+    void begin(int, bool, std::size_t edges) override
+    {
+        list.clear();
+        list.reserve(edges);
+    }
+
+    void consume(const GraphEdge* edges, std::size_t count) override
+    {
+        list.insert(list.end(), edges, edges + count);
+    }
+
+    std::vector<GraphEdge> list;
+};
@@ -0,0 +1,208 @@
+#include "graph_builder.hpp"
+#include "thread_utils.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <utility>
+
+using graph_detail::is_negative;
+
+template <typename VertexT, typename WeightT>
+unsigned ParallelGraphBuilder<VertexT, WeightT>::threads_for(VertexT vertices, std::size_t arcs) const
+{
+    unsigned requested = opts.threads ? opts.threads : std::max(1u, std::thread::hardware_concurrency());
+    const std::size_t minArcsPerThread = std::size_t(1) << 16; // below this a thread costs more than it saves
+    std::size_t byWork = std::max<std::size_t>(1, arcs / minArcsPerThread);
+    // every thread owns a histogram of V counters: all of them together stay within twice the number of arcs
+    std::size_t byMemory = std::max<std::size_t>(1, 2 * arcs / std::max<std::size_t>(1, static_cast<std::size_t>(vertices)));
+    return static_cast<unsigned>(std::min<std::size_t>({requested, byWork, byMemory}));
+}
+
+// 32-bit histogram counters whenever no list can reach 2^32 arcs (half the memory of size_t counters)
+template <typename VertexT, typename WeightT>
+BasicGraph<VertexT, WeightT> ParallelGraphBuilder<VertexT, WeightT>::build(VertexT vertices, bool directed,
+                                                                          const Edge* edges, std::size_t count) const
+{
+    if (count <= std::numeric_limits<std::uint32_t>::max() / 2)
+    {
+        return buildWith<std::uint32_t>(vertices, directed, edges, count);
+    }
+    return buildWith<std::uint64_t>(vertices, directed, edges, count);
+}
+
+template <typename VertexT, typename WeightT>
+template <typename Counter>
+BasicGraph<VertexT, WeightT> ParallelGraphBuilder<VertexT, WeightT>::buildWith(VertexT vertices, bool directed,
+                                                                              const Edge* edges, std::size_t count) const
+{
+    std::pmr::memory_resource* resource = opts.resource ? opts.resource : std::pmr::get_default_resource();
+    BasicGraph<VertexT, WeightT> g(vertices, directed, resource); // rejects a non-positive vertex count
+    const std::size_t n = static_cast<std::size_t>(vertices);
+    const unsigned T = threads_for(vertices, directed ? count : 2 * count);
+
+    // 1) validate + per-thread degree histograms: hist[t][u] = arcs chunk t adds to the list of u
+    std::vector<std::vector<Counter>> hist(T);
+    run_on_threads(T, [&](unsigned t)
+    {
+        hist[t].assign(n, 0);
+        auto [first, last] = part_range(count, T, t);
+        for (std::size_t i = first; i < last; ++i)
+        {
+            const Edge& e = edges[i];
+            if (is_negative(e.u) || e.u >= vertices || is_negative(e.v) || e.v >= vertices)
+            {
+                throw std::out_of_range("Vertex index out of range");
+            }
+            if (is_negative(e.w))
+            {
+                throw std::invalid_argument("capacity must be non-negative");
+            }
+            ++hist[t][e.u];
+            if (!directed)
+            {
+                ++hist[t][e.v];
+            }
+        }
+    });
+
+    /*
+    2) parallel prefix sum, every thread owns a block of vertices:
+    *hist[t][u] becomes the position of chunk t inside the list of u (sum of the chunks before it),
+    *offset[u] is first the start of u inside the block, then the block bases are scanned (T values)
+    and added in a second parallel pass.
+    */
+    std::vector<std::size_t> offset(n + 1, 0);
+    std::vector<std::size_t> blockBase(T + 1, 0);
+    run_on_threads(T, [&](unsigned t)
+    {
+        auto [first, last] = part_range(n, T, t);
+        std::size_t sum = 0;
+        for (std::size_t u = first; u < last; ++u)
+        {
+            Counter degree = 0;
+            for (unsigned s = 0; s < T; ++s)
+            {
+                Counter c = hist[s][u];
+                hist[s][u] = degree;
+                degree += c;
+            }
+            offset[u] = sum;
+            sum += degree;
+        }
+        blockBase[t + 1] = sum;
+    });
+    for (unsigned t = 0; t < T; ++t)
+    {
+        blockBase[t + 1] += blockBase[t];
+    }
+    run_on_threads(T, [&](unsigned t)
+    {
+        auto [first, last] = part_range(n, T, t);
+        for (std::size_t u = first; u < last; ++u)
+        {
+            offset[u] += blockBase[t];
+        }
+    });
+    offset[n] = blockBase[T];
+
+    // 3) parallel scatter into one contiguous array (left uninitialized, every slot is written exactly once)
+    std::unique_ptr<VertexT[]> target(new VertexT[offset[n]]);
+    std::unique_ptr<WeightT[]> weight(new WeightT[offset[n]]);
+    run_on_threads(T, [&](unsigned t)
+    {
+        std::vector<Counter>& pos = hist[t];
+        auto [first, last] = part_range(count, T, t);
+        for (std::size_t i = first; i < last; ++i)
+        {
+            const Edge& e = edges[i];
+            std::size_t a = offset[e.u] + pos[e.u]++;
+            target[a] = e.v;
+            weight[a] = e.w;
+            if (!directed)
+            {
+                std::size_t r = offset[e.v] + pos[e.v]++;
+                target[r] = e.u;
+                weight[r] = e.w;
+            }
+        }
+    });
+    hist.clear();
+    hist.shrink_to_fit();
+
+    /*
+    4) per-vertex lists, in parallel over blocks of vertices.
+    Sorting is stable, so parallel edges keep their input order (what KeepLast relies on); duplicates are
+    collapsed by the same routine as Graph::collapse_duplicate_edges.
+    */
+    const bool sortLists = opts.sortNeighbors || opts.duplicates != DuplicateEdgePolicy::Multigraph;
+    typename BasicGraph<VertexT, WeightT>::AdjacencyLists adj(n, resource);
+    typename BasicGraph<VertexT, WeightT>::WeightLists wts(n, resource);
+    if (opts.resource)
+    {
+        // A caller's resource (typically a per-request arena) is not assumed to be thread-safe: every list is
+        // allocated here, the workers below only fill the reserved capacity (deduplication only shrinks)
+        for (std::size_t u = 0; u < n; ++u)
+        {
+            adj[u].reserve(offset[u + 1] - offset[u]);
+            wts[u].reserve(offset[u + 1] - offset[u]);
+        }
+    }
+    std::vector<std::size_t> keptArcs(T, 0);
+    std::vector<GraphFingerprint> arcSums(T); // per-thread part of the fingerprint (a plain sum, order does not matter)
+    run_on_threads(T, [&](unsigned t)
+    {
+        auto [first, last] = part_range(n, T, t);
+        std::vector<std::pair<VertexT, WeightT>> list;
+        for (std::size_t u = first; u < last; ++u)
+        {
+            const std::size_t b = offset[u], e = offset[u + 1];
+            if (!sortLists)
+            {
+                adj[u].assign(target.get() + b, target.get() + e);
+                wts[u].assign(weight.get() + b, weight.get() + e);
+                for (std::size_t a = b; a < e; ++a)
+                {
+                    graph_detail::add_hash(arcSums[t], graph_detail::arc_hash(static_cast<VertexT>(u), target[a], weight[a], directed));
+                }
+                keptArcs[t] += e - b;
+                continue;
+            }
+
+            list.clear();
+            for (std::size_t a = b; a < e; ++a)
+            {
+                list.push_back({target[a], weight[a]});
+            }
+            std::stable_sort(list.begin(), list.end(), [](const auto& x, const auto& y) { return x.first < y.first; });
+            graph_detail::collapse_duplicates(list, static_cast<VertexT>(u), directed, opts.duplicates);
+
+            adj[u].reserve(list.size());
+            wts[u].reserve(list.size());
+            for (const auto& [v, w] : list)
+            {
+                adj[u].push_back(v);
+                wts[u].push_back(w);
+                graph_detail::add_hash(arcSums[t], graph_detail::arc_hash(static_cast<VertexT>(u), v, w, directed));
+            }
+            keptArcs[t] += list.size();
+        }
+    });
+
+    std::size_t arcs = 0;
+    for (unsigned t = 0; t < T; ++t)
+    {
+        arcs += keptArcs[t];
+        graph_detail::add_hash(g.arcSum, arcSums[t]);
+    }
+    g.adj = std::move(adj);
+    g.weights = std::move(wts);
+    g.E = opts.duplicates != DuplicateEdgePolicy::Multigraph ? (directed ? arcs : arcs / 2) : count;
+    return g;
+}
+
+#define INSTANTIATE_BUILDER(VertexT, WeightT) \
+    template class ParallelGraphBuilder<VertexT, WeightT>;
+GRAPH_FOR_EACH_TYPE(INSTANTIATE_BUILDER)
+#undef INSTANTIATE_BUILDER
@@ -0,0 +1,338 @@
+#include "graph_file.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <climits>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const char kGraphMagic[8] = {'O', 'S', 'G', 'R', 'A', 'P', 'H', '\0'};
+static constexpr std::uint32_t kByteOrderMark = 0x01020304u;
+static constexpr std::uint32_t kFlagDirected = 1u;
+
+static std::uint64_t align8(std::uint64_t n)
+{
+    return (n + 7) & ~std::uint64_t(7);
+}
+
+// Byte offset where the weights section starts (after header, offsets and padded targets)
+static std::uint64_t weights_position(std::uint64_t vertices, std::uint64_t arcs)
+{
+    return align8(sizeof(GraphFileHeader) + (vertices + 1) * sizeof(std::uint64_t) + arcs * sizeof(std::uint32_t));
+}
+
+/*
+Write the file next to its final name and rename() it into place at the end,
+so a reader never maps a half-written graph.
+*/
+void save_graph_binary(const Graph& g, const std::string& path)
+{
+    const auto& adj = g.getAdjList();
+    const auto& wts = g.getWeightList();
+    const std::uint64_t n = static_cast<std::uint64_t>(g.get_vertices());
+
+    std::vector<std::uint64_t> offsets(n + 1, 0);
+    for (std::uint64_t u = 0; u < n; ++u)
+    {
+        offsets[u + 1] = offsets[u] + adj[u].size();
+    }
+    const std::uint64_t arcs = offsets[n];
+
+    GraphFileHeader header{};
+    std::memcpy(header.magic, kGraphMagic, sizeof(kGraphMagic));
+    header.version = GRAPH_FILE_VERSION;
+    header.byteOrder = kByteOrderMark;
+    header.flags = g.is_directed() ? kFlagDirected : 0u;
+    header.vertices = n;
+    header.edges = static_cast<std::uint64_t>(g.get_edges());
+    header.arcs = arcs;
+    header.weightsPos = weights_position(n, arcs);
+
+    const std::string tmpPath = path + ".tmp";
+    std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+    if (!out)
+    {
+        throw std::runtime_error("cannot open " + tmpPath + " for writing");
+    }
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(offsets.data()), offsets.size() * sizeof(std::uint64_t));
+
+    // Graph stores int ids/capacities; both are non-negative, so they are written as-is
+    for (std::uint64_t u = 0; u < n; ++u)
+    {
+        out.write(reinterpret_cast<const char*>(adj[u].data()), adj[u].size() * sizeof(std::uint32_t));
+    }
+    static const char zeros[8] = {0};
+    std::uint64_t written = sizeof(header) + offsets.size() * sizeof(std::uint64_t) + arcs * sizeof(std::uint32_t);
+    out.write(zeros, header.weightsPos - written);
+    for (std::uint64_t u = 0; u < n; ++u)
+    {
+        out.write(reinterpret_cast<const char*>(wts[u].data()), wts[u].size() * sizeof(std::int32_t));
+    }
+
+    out.close();
+    if (!out)
+    {
+        std::remove(tmpPath.c_str());
+        throw std::runtime_error("failed writing " + tmpPath);
+    }
+    if (std::rename(tmpPath.c_str(), path.c_str()) != 0)
+    {
+        std::remove(tmpPath.c_str());
+        throw std::runtime_error("cannot rename " + tmpPath + " to " + path);
+    }
+}
+
+std::string resolve_graph_path(const std::string& dir, const std::string& name)
+{
+    if (dir.empty())
+    {
+        throw std::runtime_error("FILE is disabled: the server was started without a graph directory");
+    }
+    if (name.empty() || name[0] == '/')
+    {
+        throw std::runtime_error("graph file name must be a relative path inside the graph directory");
+    }
+    std::size_t start = 0;
+    while (start <= name.size())
+    {
+        std::size_t end = name.find('/', start);
+        if (end == std::string::npos)
+        {
+            end = name.size();
+        }
+        if (name.compare(start, end - start, "..") == 0 && end - start == 2)
+        {
+            throw std::runtime_error("graph file name must not contain '..'");
+        }
+        start = end + 1;
+    }
+
+    // realpath follows symlinks, so a link pointing out of the directory is caught by the prefix check
+    char* root = ::realpath(dir.c_str(), nullptr);
+    if (!root)
+    {
+        throw std::runtime_error("graph directory is not available");
+    }
+    std::string base(root);
+    std::free(root);
+    char* resolved = ::realpath((base + "/" + name).c_str(), nullptr);
+    if (!resolved)
+    {
+        throw std::runtime_error("cannot open graph file " + name);
+    }
+    std::string path(resolved);
+    std::free(resolved);
+    if (path.compare(0, base.size() + 1, base + "/") != 0)
+    {
+        throw std::runtime_error("graph file is outside the graph directory");
+    }
+    return path;
+}
+
+/*
+Open + validate:
+1. mmap the whole file read-only.
+2. Check magic, version, byte order and that the section sizes match the file size.
+3. Check that the arc count matches the edge count (one arc per directed edge, two per undirected edge).
+4. Check that the offsets are monotonic and end at arcs, and that every target is a valid vertex,
+so the accessors can index the arrays without further checks (one sequential O(V + E) pass).
+*/
+MappedGraph::MappedGraph(const std::string& path)
+{
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        throw std::runtime_error("cannot open graph file " + path);
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(GraphFileHeader)))
+    {
+        ::close(fd);
+        throw std::runtime_error("not a graph file: " + path);
+    }
+    length = static_cast<std::size_t>(st.st_size);
+    base = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // the mapping keeps the file alive
+    if (base == MAP_FAILED)
+    {
+        base = nullptr;
+        throw std::runtime_error("cannot mmap graph file " + path);
+    }
+
+    try
+    {
+        const auto* bytes = static_cast<const unsigned char*>(base);
+        GraphFileHeader header;
+        std::memcpy(&header, bytes, sizeof(header));
+        if (std::memcmp(header.magic, kGraphMagic, sizeof(kGraphMagic)) != 0)
+        {
+            throw std::runtime_error("not a graph file: " + path);
+        }
+        if (header.version != GRAPH_FILE_VERSION)
+        {
+            throw std::runtime_error("unsupported graph file version " + std::to_string(header.version));
+        }
+        if (header.byteOrder != kByteOrderMark)
+        {
+            throw std::runtime_error("graph file was written with a different byte order");
+        }
+        if (header.vertices == 0 || header.vertices > static_cast<std::uint64_t>(INT_MAX) ||
+            header.edges > static_cast<std::uint64_t>(INT_MAX) || header.arcs > (std::uint64_t(1) << 40))
+        {
+            throw std::runtime_error("corrupt graph file header");
+        }
+        if (header.weightsPos != weights_position(header.vertices, header.arcs) ||
+            header.weightsPos + header.arcs * sizeof(std::int32_t) != length)
+        {
+            throw std::runtime_error("graph file size does not match its header");
+        }
+
+        if (header.arcs != ((header.flags & kFlagDirected) ? header.edges : 2 * header.edges))
+        {
+            throw std::runtime_error("graph file edge count does not match its arcs");
+        }
+
+        V = static_cast<int>(header.vertices);
+        E = static_cast<int>(header.edges);
+        directed = (header.flags & kFlagDirected) != 0;
+        offset = reinterpret_cast<const std::uint64_t*>(bytes + sizeof(GraphFileHeader));
+        target = reinterpret_cast<const VertexId*>(offset + V + 1);
+        weight = reinterpret_cast<const int*>(bytes + header.weightsPos);
+
+        if (offset[0] != 0 || offset[V] != header.arcs)
+        {
+            throw std::runtime_error("corrupt graph file offsets");
+        }
+        for (int u = 0; u < V; ++u)
+        {
+            if (offset[u] > offset[u + 1])
+            {
+                throw std::runtime_error("corrupt graph file offsets");
+            }
+        }
+        for (std::uint64_t a = 0; a < header.arcs; ++a)
+        {
+            if (target[a] >= static_cast<VertexId>(V) || weight[a] < 0)
+            {
+                throw std::runtime_error("corrupt graph file arcs");
+            }
+        }
+    }
+    catch (...)
+    {
+        unmap();
+        throw;
+    }
+}
+
+MappedGraph::~MappedGraph()
+{
+    unmap();
+}
+
+MappedGraph::MappedGraph(MappedGraph&& other) noexcept
+{
+    *this = std::move(other);
+}
+
+MappedGraph& MappedGraph::operator=(MappedGraph&& other) noexcept
+{
+    if (this != &other)
+    {
+        unmap();
+        base = std::exchange(other.base, nullptr);
+        length = std::exchange(other.length, 0);
+        V = std::exchange(other.V, 0);
+        E = std::exchange(other.E, 0);
+        directed = other.directed;
+        offset = std::exchange(other.offset, nullptr);
+        target = std::exchange(other.target, nullptr);
+        weight = std::exchange(other.weight, nullptr);
+    }
+    return *this;
+}
+
+void MappedGraph::unmap()
+{
+    if (base)
+    {
+        ::munmap(base, length);
+        base = nullptr;
+        length = 0;
+    }
+}
+
+void MappedGraph::check_vertex(int u) const
+{
+    if (u < 0 || u >= V)
+    {
+        throw std::out_of_range("Vertex index out of range");
+    }
+}
+
+int MappedGraph::degree(int u) const
+{
+    check_vertex(u);
+    return static_cast<int>(offset[u + 1] - offset[u]);
+}
+
+MappedGraph::Slice<MappedGraph::VertexId> MappedGraph::get_neighbors(int u) const
+{
+    check_vertex(u);
+    return {target + offset[u], target + offset[u + 1]};
+}
+
+MappedGraph::Slice<int> MappedGraph::get_weights(int u) const
+{
+    check_vertex(u);
+    return {weight + offset[u], weight + offset[u + 1]};
+}
+
+bool MappedGraph::is_edge(int u, int v) const
+{
+    for (VertexId x : get_neighbors(u))
+    {
+        if (static_cast<int>(x) == v)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+// One exact-size copy per list (capacity == size), then the lists are moved into the Graph
+Graph MappedGraph::to_graph(std::pmr::memory_resource* resource) const
+{
+    Graph::AdjacencyLists adj(V, resource);
+    Graph::WeightLists wts(V, resource);
+    for (int u = 0; u < V; ++u)
+    {
+        adj[u].assign(target + offset[u], target + offset[u + 1]);
+        wts[u].assign(weight + offset[u], weight + offset[u + 1]);
+    }
+    return Graph::fromAdjacency(V, directed, E, std::move(adj), std::move(wts));
+}
+
+// Print graph (for debugging), same format as Graph::print()
+void MappedGraph::print() const
+{
+    for (int u = 0; u < V; u++)
+    {
+        std::cout << u << ": ";
+        for (VertexId v : get_neighbors(u))
+        {
+            std::cout << v << " ";
+        }
+        std::cout << "\n";
+    }
+}
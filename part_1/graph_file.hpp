@@ -0,0 +1,113 @@
+/*
+@ author: Roy Meoded
+@ author: Yarin Keshet
+
+@ description: Versioned binary on-disk format for graphs, opened with mmap.
+                A graph file is written once (save_graph_binary) and can then be opened by MappedGraph
+                without text parsing: the file already is the CSR layout, so opening it is one mmap() plus
+                one sequential validation pass over the header and the arrays (O(V + E), no allocation), and
+                the neighbor lists are read straight from the page cache.
+                This is a fast binary loader, not zero-copy: part_4 and the part_8/part_9 servers copy the
+                mapping into a Graph with to_graph() (their algorithms and caches work on Graph), so what they
+                save is the text parsing and per-edge insertion, not the O(E) copy.
+
+                File layout (native byte order, every section 8-byte aligned):
+                    header   GraphFileHeader (56 bytes)
+                    offsets  uint64[V+1]   arcs of u are [offsets[u], offsets[u+1])
+                    targets  uint32[arcs]  head vertex of every arc
+                    (padding to 8 bytes)
+                    weights  int32[arcs]   capacity of every arc
+                An undirected edge is stored as two arcs (like Graph and CsrGraph); "edges" in the header is
+                the logical edge count.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+#include "graph_impl.hpp"
+#include "csr_graph.hpp"
+
+struct GraphFileHeader
+{
+    char magic[8];            // "OSGRAPH\0"
+    std::uint32_t version;    // GRAPH_FILE_VERSION
+    std::uint32_t byteOrder;  // 0x01020304 as written by the producer, detects foreign-endian files
+    std::uint32_t flags;      // bit 0: directed
+    std::uint32_t reserved;
+    std::uint64_t vertices;
+    std::uint64_t edges;      // logical edges (undirected edge counts once)
+    std::uint64_t arcs;       // stored arcs (size of targets/weights)
+    std::uint64_t weightsPos; // byte offset of the weights section
+};
+
+static_assert(sizeof(GraphFileHeader) == 56, "GraphFileHeader must have a fixed layout");
+
+constexpr std::uint32_t GRAPH_FILE_VERSION = 1;
+
+// Write g to path in the binary format (throws std::runtime_error on I/O errors)
+void save_graph_binary(const Graph& g, const std::string& path);
+
+/*
+Resolve a graph file name sent by a remote client against the graph directory of a server.
+Only relative names without ".." components are accepted, and the resolved path (symlinks followed) must still
+lie inside dir. Throws std::runtime_error otherwise, or when dir is empty (no directory configured: FILE disabled).
+*/
+std::string resolve_graph_path(const std::string& dir, const std::string& name);
+
+class MappedGraph
+{
+public:
+    using VertexId = CsrGraph::VertexId;
+    template <typename T>
+    using Slice = CsrGraph::Slice<T>;
+
+    // Map a graph file read-only (throws std::runtime_error if it is missing, truncated or not a graph file)
+    explicit MappedGraph(const std::string& path);
+    ~MappedGraph();
+
+    MappedGraph(const MappedGraph&) = delete;
+    MappedGraph& operator=(const MappedGraph&) = delete;
+    MappedGraph(MappedGraph&& other) noexcept;
+    MappedGraph& operator=(MappedGraph&& other) noexcept;
+
+    int get_vertices() const { return V; }
+    int get_edges() const { return E; }
+    bool is_directed() const { return directed; }
+
+    // Number of stored arcs leaving u
+    int degree(int u) const;
+
+    // Neighbors / capacities of u (parallel slices, pointing into the mapping)
+    Slice<VertexId> get_neighbors(int u) const;
+    Slice<int> get_weights(int u) const;
+
+    // Returns true if there is an edge from u to v
+    bool is_edge(int u, int v) const;
+
+    // Raw CSR arrays (V+1 offsets, arcs targets/weights)
+    const std::uint64_t* get_offsets() const { return offset; }
+    const VertexId* get_targets() const { return target; }
+    const int* get_weight_array() const { return weight; }
+
+    // Copy into a regular (mutable) Graph, neighbor order of every vertex is preserved (lists allocated from resource)
+    Graph to_graph(std::pmr::memory_resource* resource = std::pmr::get_default_resource()) const;
+
+    // Print graph (for debugging)
+    void print() const;
+
+private:
+    void* base = nullptr;
+    std::size_t length = 0;
+    int V = 0;
+    int E = 0;
+    bool directed = false;
+    const std::uint64_t* offset = nullptr;
+    const VertexId* target = nullptr;
+    const int* weight = nullptr;
+
+    void check_vertex(int u) const;
+    void unmap();
+};
@@ -1,51 +1,483 @@
 #include "graph_impl.hpp"
 
-void Graph::addEdge(int u, int v, int cap) 
+#include <climits>
+#include <cstdio>
+
+using graph_detail::is_negative;
+
+std::string GraphFingerprint::to_string() const
+{
+    char buf[33];
+    std::snprintf(buf, sizeof(buf), "%016llx%016llx", static_cast<unsigned long long>(hi), static_cast<unsigned long long>(lo));
+    return buf;
+}
+
+template <typename VertexT, typename WeightT>
+void BasicGraph<VertexT, WeightT>::addEdge(VertexT u, VertexT v, WeightT cap)
 {
-    if (u < 0 || u >= V || v < 0 || v >= V) {
+    if (is_negative(u) || u >= V || is_negative(v) || v >= V) {
         throw std::out_of_range("Vertex index out of range");
     }
-    if (cap < 0) {
+    if (is_negative(cap)) {
         throw std::invalid_argument("capacity must be non-negative");
     }
 
     adj[u].push_back(v);
-    capacity[u][v] = cap;
-    if (!directed) 
+    weights[u].push_back(cap);
+    GraphFingerprint h = graph_detail::arc_hash(u, v, cap, directed);
+    graph_detail::add_hash(arcSum, h);
+    if (!directed)
     {
         adj[v].push_back(u);
-        capacity[v][u] = cap;
+        weights[v].push_back(cap);
+        graph_detail::add_hash(arcSum, h); // the reverse arc hashes the same
     }
     ++E;
+    record(Change::Kind::Add, u, v, cap, cap);
+
+    // Keep the edge index in sync (only the bit matrix supports O(1) inserts):
+    if (index.ready())
+    {
+        bool kept = index.insert(static_cast<int>(u), static_cast<int>(v)) &&
+                    (directed || index.insert(static_cast<int>(v), static_cast<int>(u)));
+        if (!kept)
+        {
+            index.clear();
+        }
+    }
+}
+
+template <typename VertexT, typename WeightT>
+BasicGraph<VertexT, WeightT> BasicGraph<VertexT, WeightT>::fromAdjacency(VertexT vertices, bool isDirected, std::size_t edges,
+                                                                         AdjacencyLists&& adjacency, WeightLists&& weightLists)
+{
+    BasicGraph g(vertices, isDirected, adjacency.get_allocator().resource()); // same resource: the lists below are moved, not copied
+    if (adjacency.size() != static_cast<std::size_t>(vertices) || weightLists.size() != static_cast<std::size_t>(vertices))
+    {
+        throw std::invalid_argument("adjacency/weight lists do not match the number of vertices");
+    }
+    for (VertexT u = 0; u < vertices; ++u)
+    {
+        if (adjacency[u].size() != weightLists[u].size())
+        {
+            throw std::invalid_argument("adjacency/weight lists do not match");
+        }
+        for (size_t i = 0; i < adjacency[u].size(); ++i)
+        {
+            if (is_negative(adjacency[u][i]) || adjacency[u][i] >= vertices)
+            {
+                throw std::out_of_range("Vertex index out of range");
+            }
+            if (is_negative(weightLists[u][i]))
+            {
+                throw std::invalid_argument("capacity must be non-negative");
+            }
+            graph_detail::add_hash(g.arcSum, graph_detail::arc_hash(u, adjacency[u][i], weightLists[u][i], isDirected));
+        }
+    }
+    g.adj = std::move(adjacency);
+    g.weights = std::move(weightLists);
+    g.E = edges;
+    return g;
+}
+
+template <typename VertexT, typename WeightT>
+void BasicGraph<VertexT, WeightT>::addEdges(const Edge* edges, std::size_t count)
+{
+    // 1) validate everything before touching the graph
+    std::vector<std::size_t> extra(V, 0); // extra[u] = number of new entries in adj[u]
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const Edge& e = edges[i];
+        if (is_negative(e.u) || e.u >= V || is_negative(e.v) || e.v >= V)
+        {
+            throw std::out_of_range("Vertex index out of range");
+        }
+        if (is_negative(e.w))
+        {
+            throw std::invalid_argument("capacity must be non-negative");
+        }
+        ++extra[e.u];
+        if (!directed)
+        {
+            ++extra[e.v];
+        }
+    }
+
+    // 2) reserve the exact final size of every touched list
+    for (VertexT u = 0; u < V; ++u)
+    {
+        if (extra[u] > 0)
+        {
+            adj[u].reserve(adj[u].size() + extra[u]);
+            weights[u].reserve(weights[u].size() + extra[u]);
+        }
+    }
+
+    // 3) fill (no reallocation can happen any more)
+    bool keepIndex = index.ready();
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const Edge& e = edges[i];
+        adj[e.u].push_back(e.v);
+        weights[e.u].push_back(e.w);
+        GraphFingerprint h = graph_detail::arc_hash(e.u, e.v, e.w, directed);
+        graph_detail::add_hash(arcSum, h);
+        if (!directed)
+        {
+            adj[e.v].push_back(e.u);
+            weights[e.v].push_back(e.w);
+            graph_detail::add_hash(arcSum, h);
+        }
+        record(Change::Kind::Add, e.u, e.v, e.w, e.w);
+        if (keepIndex)
+        {
+            keepIndex = index.insert(static_cast<int>(e.u), static_cast<int>(e.v)) &&
+                        (directed || index.insert(static_cast<int>(e.v), static_cast<int>(e.u)));
+        }
+    }
+    E += count;
+    if (index.ready() && !keepIndex)
+    {
+        index.clear();
+    }
+}
+
+DuplicateEdgePolicy parse_duplicate_policy(const std::string& name)
+{
+    if (name == "MULTI") return DuplicateEdgePolicy::Multigraph;
+    if (name == "REJECT") return DuplicateEdgePolicy::Reject;
+    if (name == "LAST") return DuplicateEdgePolicy::KeepLast;
+    if (name == "MAX") return DuplicateEdgePolicy::KeepMax;
+    if (name == "SUM") return DuplicateEdgePolicy::SumCapacities;
+    throw std::invalid_argument("unknown duplicate edge policy: " + name);
+}
+
+/*
+Two passes over the vertices, each list copied into (target, weight) pairs and stably sorted:
+1) if the policy can throw (Reject, SumCapacities), collapse every list into the scratch copy only,
+   so an error leaves the graph unchanged (Reject stops here: there is nothing to merge),
+2) collapse again and write the merged lists back, recomputing E and the fingerprint sum.
+The set of (u, v) pairs does not change, so a ready edge index stays valid.
+*/
+template <typename VertexT, typename WeightT>
+std::size_t BasicGraph<VertexT, WeightT>::collapse_duplicate_edges(DuplicateEdgePolicy policy)
+{
+    if (policy == DuplicateEdgePolicy::Multigraph)
+    {
+        return 0;
+    }
+
+    std::vector<std::pair<VertexT, WeightT>> list;
+    auto sortedList = [&](VertexT u)
+    {
+        list.clear();
+        for (std::size_t i = 0; i < adj[u].size(); ++i)
+        {
+            list.push_back({adj[u][i], weights[u][i]});
+        }
+        std::stable_sort(list.begin(), list.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+    };
+
+    if (policy == DuplicateEdgePolicy::Reject || policy == DuplicateEdgePolicy::SumCapacities)
+    {
+        for (VertexT u = 0; u < V; ++u)
+        {
+            sortedList(u);
+            graph_detail::collapse_duplicates(list, u, directed, policy);
+        }
+        if (policy == DuplicateEdgePolicy::Reject)
+        {
+            return 0;
+        }
+    }
+
+    std::size_t arcs = 0;
+    GraphFingerprint sum;
+    for (VertexT u = 0; u < V; ++u)
+    {
+        sortedList(u);
+        graph_detail::collapse_duplicates(list, u, directed, policy);
+        adj[u].resize(list.size());
+        weights[u].resize(list.size());
+        for (std::size_t i = 0; i < list.size(); ++i)
+        {
+            adj[u][i] = list[i].first;
+            weights[u][i] = list[i].second;
+            graph_detail::add_hash(sum, graph_detail::arc_hash(u, list[i].first, list[i].second, directed));
+        }
+        arcs += list.size();
+    }
+
+    std::size_t before = E;
+    E = directed ? arcs : arcs / 2;
+    arcSum = sum;
+    if (E != before)
+    {
+        // a new version, and the log restarts from it (changes_since older versions returns false)
+        ++ver;
+        logStart = ver;
+        changeLog.clear();
+    }
+    return before - E;
+}
+
+template <typename VertexT, typename WeightT>
+void BasicGraph<VertexT, WeightT>::record(typename Change::Kind kind, VertexT u, VertexT v, WeightT w, WeightT previous)
+{
+    ++ver;
+    if (logging)
+    {
+        changeLog.push_back({kind, u, v, w, previous, ver});
+    }
+}
+
+template <typename VertexT, typename WeightT>
+bool BasicGraph<VertexT, WeightT>::removeEdge(VertexT u, VertexT v)
+{
+    if (is_negative(u) || u >= V || is_negative(v) || v >= V) {
+        throw std::out_of_range("Vertex index out of range");
+    }
+    auto it = std::find(adj[u].begin(), adj[u].end(), v);
+    if (it == adj[u].end())
+    {
+        return false;
+    }
+    std::size_t i = static_cast<std::size_t>(it - adj[u].begin());
+    WeightT cap = weights[u][i];
+    adj[u].erase(it);
+    weights[u].erase(weights[u].begin() + i);
+    GraphFingerprint h = graph_detail::arc_hash(u, v, cap, directed);
+    graph_detail::sub_hash(arcSum, h);
+    if (!directed)
+    {
+        // The other half: same capacity, in the list of v (for a self-loop, the second copy in the same list)
+        for (std::size_t j = 0; j < adj[v].size(); ++j)
+        {
+            if (adj[v][j] == u && weights[v][j] == cap)
+            {
+                adj[v].erase(adj[v].begin() + j);
+                weights[v].erase(weights[v].begin() + j);
+                break;
+            }
+        }
+        graph_detail::sub_hash(arcSum, h);
+    }
+    --E;
+    record(Change::Kind::Remove, u, v, cap, cap);
+
+    // The index only forgets u->v once no parallel copy is left (only the bit matrix supports O(1) erases):
+    if (index.ready() && std::find(adj[u].begin(), adj[u].end(), v) == adj[u].end())
+    {
+        bool kept = index.erase(static_cast<int>(u), static_cast<int>(v)) &&
+                    (directed || index.erase(static_cast<int>(v), static_cast<int>(u)));
+        if (!kept)
+        {
+            index.clear();
+        }
+    }
+    return true;
+}
+
+template <typename VertexT, typename WeightT>
+bool BasicGraph<VertexT, WeightT>::setWeight(VertexT u, VertexT v, WeightT cap)
+{
+    if (is_negative(u) || u >= V || is_negative(v) || v >= V) {
+        throw std::out_of_range("Vertex index out of range");
+    }
+    if (is_negative(cap)) {
+        throw std::invalid_argument("capacity must be non-negative");
+    }
+    auto it = std::find(adj[u].begin(), adj[u].end(), v);
+    if (it == adj[u].end())
+    {
+        return false;
+    }
+    std::size_t i = static_cast<std::size_t>(it - adj[u].begin());
+    WeightT previous = weights[u][i];
+    weights[u][i] = cap;
+    GraphFingerprint before = graph_detail::arc_hash(u, v, previous, directed);
+    GraphFingerprint after = graph_detail::arc_hash(u, v, cap, directed);
+    graph_detail::sub_hash(arcSum, before);
+    graph_detail::add_hash(arcSum, after);
+    if (!directed)
+    {
+        for (std::size_t j = 0; j < adj[v].size(); ++j)
+        {
+            if (adj[v][j] == u && weights[v][j] == previous && !(v == u && j == i))
+            {
+                weights[v][j] = cap;
+                break;
+            }
+        }
+        graph_detail::sub_hash(arcSum, before);
+        graph_detail::add_hash(arcSum, after);
+    }
+    record(Change::Kind::SetWeight, u, v, cap, previous);
+    return true;
+}
+
+template <typename VertexT, typename WeightT>
+void BasicGraph<VertexT, WeightT>::enable_change_log(bool on)
+{
+    logging = on;
+    logStart = ver;
+    changeLog.clear();
+    changeLog.shrink_to_fit();
+}
+
+// Versions in the log are consecutive, so the first change after since is found by subtraction
+template <typename VertexT, typename WeightT>
+bool BasicGraph<VertexT, WeightT>::changes_since(std::uint64_t since, std::vector<Change>& out) const
+{
+    if (!logging || since < logStart || since > ver)
+    {
+        return false;
+    }
+    out.assign(changeLog.begin() + static_cast<std::ptrdiff_t>(since - logStart), changeLog.end());
+    return true;
+}
+
+template <typename VertexT, typename WeightT>
+void BasicGraph<VertexT, WeightT>::trim_change_log(std::uint64_t upTo)
+{
+    if (!logging || upTo <= logStart)
+    {
+        return; // nothing recorded, or already trimmed that far
+    }
+    upTo = std::min(upTo, ver);
+    const std::size_t drop = std::min(static_cast<std::size_t>(upTo - logStart), changeLog.size());
+    changeLog.erase(changeLog.begin(), changeLog.begin() + static_cast<std::ptrdiff_t>(drop));
+    logStart = upTo;
 }
 
 // Return adjacency list of a vertex
-const std::vector<int>& Graph::get_neighbors(int u) const 
+template <typename VertexT, typename WeightT>
+const typename BasicGraph<VertexT, WeightT>::NeighborList& BasicGraph<VertexT, WeightT>::get_neighbors(VertexT u) const
 {
-    if (u < 0 || u >= V) 
+    if (is_negative(u) || u >= V)
     {
         throw std::out_of_range("Vertex index out of range");
     }
     return adj[u];
 }
 
-bool Graph::is_edge(int u, int v) const 
+// Return the capacities of the edges leaving u
+template <typename VertexT, typename WeightT>
+const typename BasicGraph<VertexT, WeightT>::WeightList& BasicGraph<VertexT, WeightT>::get_weights(VertexT u) const
+{
+    if (is_negative(u) || u >= V)
+    {
+        throw std::out_of_range("Vertex index out of range");
+    }
+    return weights[u];
+}
+
+/*
+Capacity lookup served from the edge storage:
+*Scans the neighbors of u for v, from the back so the most recently added u->v edge wins
+(same result the old capacity matrix gave when an edge was added twice).
+*Returns 0 if there is no edge u->v.
+*/
+template <typename VertexT, typename WeightT>
+WeightT BasicGraph<VertexT, WeightT>::get_capacity(VertexT u, VertexT v) const
+{
+    const auto& neighbors = get_neighbors(u);
+    if (is_negative(v) || v >= V)
+    {
+        throw std::out_of_range("Vertex index out of range");
+    }
+    for (size_t i = neighbors.size(); i-- > 0; )
+    {
+        if (neighbors[i] == v)
+        {
+            return weights[u][i];
+        }
+    }
+    return 0;
+}
+
+template <typename VertexT, typename WeightT>
+bool BasicGraph<VertexT, WeightT>::is_edge(VertexT u, VertexT v) const
 {
     // Using const auto& ensures that the returned reference is not copied into a new vector:
     const auto& neighbors = get_neighbors(u);
+    if (is_negative(v) || v >= V)
+    {
+        return false;
+    }
+    if (index.ready())
+    {
+        return index.contains(static_cast<int>(u), static_cast<int>(v));
+    }
     return std::find(neighbors.begin(), neighbors.end(), v) != neighbors.end();
 }
 
+// The index addresses vertices with int, so it is only available for graphs up to INT_MAX vertices
+template <typename VertexT, typename WeightT>
+void BasicGraph<VertexT, WeightT>::build_edge_index()
+{
+    if (static_cast<std::uint64_t>(V) > static_cast<std::uint64_t>(INT_MAX))
+    {
+        throw std::length_error("edge index supports at most INT_MAX vertices");
+    }
+    index = EdgeIndex(static_cast<int>(V), adj);
+}
+
+template <typename VertexT, typename WeightT>
+GraphMemoryUsage BasicGraph<VertexT, WeightT>::memory_usage() const
+{
+    GraphMemoryUsage usage;
+    for (VertexT u = 0; u < V; ++u)
+    {
+        usage.adjacency += adj[u].capacity() * sizeof(VertexT);
+        usage.weights += weights[u].capacity() * sizeof(WeightT);
+    }
+    usage.overhead = sizeof(*this) + adj.capacity() * sizeof(NeighborList) + weights.capacity() * sizeof(WeightList) +
+                     index.memory_bytes() + changeLog.capacity() * sizeof(Change);
+    return usage;
+}
+
+// An undirected edge is stored as two arcs; no edge index, no change log
+template <typename VertexT, typename WeightT>
+GraphMemoryUsage BasicGraph<VertexT, WeightT>::estimate_memory(VertexT vertices, std::size_t edges, bool isDirected)
+{
+    const std::size_t n = is_negative(vertices) ? 0 : static_cast<std::size_t>(vertices);
+    const std::size_t arcs = isDirected ? edges : 2 * edges;
+    GraphMemoryUsage usage;
+    usage.adjacency = arcs * sizeof(VertexT);
+    usage.weights = arcs * sizeof(WeightT);
+    usage.overhead = sizeof(BasicGraph) + n * (sizeof(NeighborList) + sizeof(WeightList));
+    return usage;
+}
+
+// The arc sum is combined with the shape (V, directed) only here, so addEdge stays a couple of additions
+template <typename VertexT, typename WeightT>
+GraphFingerprint BasicGraph<VertexT, WeightT>::fingerprint() const
+{
+    return graph_detail::shape_hash(arcSum, static_cast<std::uint64_t>(V), directed);
+}
+
 // Print graph (for debugging)
-void Graph::print() const 
+template <typename VertexT, typename WeightT>
+void BasicGraph<VertexT, WeightT>::print() const
 {
-    for (int u = 0; u < V; u++) 
+    for (VertexT u = 0; u < V; u++)
     {
         std::cout << u << ": ";
-        for (int v : adj[u]) 
+        for (VertexT v : adj[u])
         {
             std::cout << v << " ";
         }
         std::cout << "\n";
     }
-}
\ No newline at end of file
+}
+
+static_assert(std::is_same_v<std::int32_t, int>, "Graph is expected to be BasicGraph<int, std::int32_t>");
+
+#define INSTANTIATE_GRAPH(VertexT, WeightT) \
+    template struct BasicGraphEdge<VertexT, WeightT>; \
+    template struct BasicGraphChange<VertexT, WeightT>; \
+    template class BasicGraph<VertexT, WeightT>;
+GRAPH_FOR_EACH_TYPE(INSTANTIATE_GRAPH)
+#undef INSTANTIATE_GRAPH
@@ -5,8 +5,13 @@
 
 @ description: Graph implementation using adjacency list representation.
                 Supports both directed and undirected graphs with capacities on edges.
+                Capacities are stored next to the adjacency entries (weights[u][i] belongs to adj[u][i]),
+                so memory is O(V+E) instead of a dense VxV matrix.
                 Includes methods for adding edges, retrieving neighbors, checking edge existence, and printing the graph.
                 Designed for use in network flow algorithms and other graph-related computations.
+                The class is a template on the vertex-id type (int, uint32_t, uint64_t) and the weight type
+                (uint8_t, uint16_t, int32_t, int64_t): compact weights shrink unit-weight graphs, 64-bit weights
+                keep large capacities exact. Graph (int ids, int weights) is the default everything else uses.
 */
 
 
@@ -14,18 +19,256 @@
 
 #include <iostream>
 #include <vector>
+#include <memory_resource>
 #include <stdexcept>
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <string>
+#include <utility>
+#include <limits>
 
+#include "edge_index.hpp"
 
-class Graph 
+namespace graph_detail 
 {
+    // x < 0 for signed types, always false for unsigned ones (avoids "comparison is always false" warnings)
+    template <typename T>
+    constexpr bool is_negative(T x) 
+    {
+        if constexpr (std::is_signed_v<T>) 
+        {
+            return x < 0;
+        } 
+        else 
+        {
+            (void)x;
+            return false;
+        }
+    }
+}
+
+/*
+128-bit content hash of a graph: vertex count, directed flag and the multiset of its (u, v, w) edges.
+Every edge adds its own 128-bit hash to a running sum, so the value does not depend on insertion order
+and is updated in O(1) per added edge (no pass over the graph is ever needed to read it).
+Undirected edges are hashed as (min(u,v), max(u,v), w). Equal graphs always have equal fingerprints;
+different graphs collide with probability ~2^-128, good enough to key result caches.
+*/
+struct GraphFingerprint
+{
+    std::uint64_t hi = 0;
+    std::uint64_t lo = 0;
+
+    bool operator==(const GraphFingerprint& other) const { return hi == other.hi && lo == other.lo; }
+    bool operator!=(const GraphFingerprint& other) const { return !(*this == other); }
+
+    // 32 hex digits
+    std::string to_string() const;
+};
+
+namespace graph_detail 
+{
+    // splitmix64 finalizer: a cheap, well-distributed 64-bit mixer
+    constexpr std::uint64_t mix64(std::uint64_t x) 
+    {
+        x += 0x9e3779b97f4a7c15ULL;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+
+    // Hash of one stored arc u->v with weight w, two independent 64-bit lanes (added into GraphFingerprint)
+    template <typename VertexT, typename WeightT>
+    GraphFingerprint arc_hash(VertexT u, VertexT v, WeightT w, bool directed) 
+    {
+        std::uint64_t a = static_cast<std::uint64_t>(u), b = static_cast<std::uint64_t>(v);
+        if (!directed && b < a) 
+        {
+            std::swap(a, b);
+        }
+        std::uint64_t c = static_cast<std::uint64_t>(static_cast<std::int64_t>(w));
+        return {mix64(mix64(mix64(a ^ 0x6a09e667f3bcc908ULL) ^ b) ^ c), mix64(mix64(mix64(a ^ 0xbb67ae8584caa73bULL) ^ b) ^ c)};
+    }
+
+    inline void add_hash(GraphFingerprint& sum, const GraphFingerprint& h) 
+    {
+        sum.hi += h.hi;
+        sum.lo += h.lo;
+    }
+
+    inline void sub_hash(GraphFingerprint& sum, const GraphFingerprint& h) 
+    {
+        sum.hi -= h.hi;
+        sum.lo -= h.lo;
+    }
+
+    // Fingerprint of a graph from the sum of its arc hashes and its shape (V, directed)
+    inline GraphFingerprint shape_hash(const GraphFingerprint& arcs, std::uint64_t vertices, bool directed) 
+    {
+        std::uint64_t shape = mix64(vertices * 2 + (directed ? 1 : 0));
+        return {mix64(arcs.hi ^ shape), mix64(arcs.lo + shape)};
+    }
+}
+
+// A single weighted edge u -> v (used for bulk construction from edge lists)
+template <typename VertexT, typename WeightT>
+struct BasicGraphEdge 
+{
+    VertexT u;
+    VertexT v;
+    WeightT w = 1; // default capacity is 1 if not specified
+};
+
+/*
+What to do with repeated edges (same u -> v, or the same unordered pair in an undirected graph):
+*Multigraph - keep every copy (the default, addEdge never merges),
+*Reject - throw std::invalid_argument naming the first repeated edge,
+*KeepLast / KeepMax - keep one edge with the capacity of the last added copy / the largest capacity,
+*SumCapacities - keep one edge with the sum of the capacities (std::overflow_error if the weight type overflows).
+*/
+enum class DuplicateEdgePolicy 
+{
+    Multigraph,
+    Reject,
+    KeepLast,
+    KeepMax,
+    SumCapacities
+};
+
+// Policy by protocol name: MULTI, REJECT, LAST, MAX, SUM (std::invalid_argument for anything else)
+DuplicateEdgePolicy parse_duplicate_policy(const std::string& name);
+
+namespace graph_detail 
+{
+    /*
+    Collapse the runs of equal targets in the neighbor list of u, sorted by target (stable, so a run is in
+    insertion order). An undirected self-loop is stored twice in the list of its vertex: a run of 2k entries
+    there is k edges and stays 2 entries.
+    */
+    template <typename VertexT, typename WeightT>
+    void collapse_duplicates(std::vector<std::pair<VertexT, WeightT>>& list, VertexT u, bool directed, DuplicateEdgePolicy policy) 
+    {
+        if (policy == DuplicateEdgePolicy::Multigraph) 
+        {
+            return;
+        }
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < list.size(); ) 
+        {
+            std::size_t j = i + 1;
+            while (j < list.size() && list[j].first == list[i].first) 
+            {
+                ++j;
+            }
+            const std::size_t halves = (!directed && list[i].first == u) ? 2 : 1;
+            if (j - i > halves && policy == DuplicateEdgePolicy::Reject) 
+            {
+                throw std::invalid_argument("duplicate edge " + std::to_string(u) + " -> " + std::to_string(list[i].first));
+            }
+
+            WeightT w = list[j - 1].second; // KeepLast
+            if (policy == DuplicateEdgePolicy::KeepMax) 
+            {
+                for (std::size_t k = i; k < j; ++k) 
+                {
+                    w = std::max(w, list[k].second);
+                }
+            }
+            else if (policy == DuplicateEdgePolicy::SumCapacities) 
+            {
+                w = 0;
+                for (std::size_t k = i; k < j; k += halves) // one half of every self-loop
+                {
+                    if (list[k].second > std::numeric_limits<WeightT>::max() - w) 
+                    {
+                        throw std::overflow_error("summed capacity of edge " + std::to_string(u) + " -> " +
+                                                  std::to_string(list[i].first) + " overflows the weight type");
+                    }
+                    w += list[k].second;
+                }
+            }
+            for (std::size_t k = 0; k < halves; ++k) 
+            {
+                list[kept++] = {list[i].first, w};
+            }
+            i = j;
+        }
+        list.resize(kept);
+    }
+}
+
+// Bytes held by a graph, by kind of storage (see BasicGraph::memory_usage / estimate_memory)
+struct GraphMemoryUsage 
+{
+    std::size_t adjacency = 0; // neighbor ids
+    std::size_t weights = 0;   // capacities
+    std::size_t overhead = 0;  // the graph object, one vector header per list, edge index, change log
+
+    std::size_t total() const { return adjacency + weights + overhead; }
+};
+
+// One mutation of a graph, as recorded by its change log (see BasicGraph::changes_since)
+template <typename VertexT, typename WeightT>
+struct BasicGraphChange 
+{
+    enum class Kind 
+    {
+        Add,       // edge u -> v added with capacity weight
+        Remove,    // edge u -> v with capacity weight removed
+        SetWeight  // capacity of edge u -> v changed from previous to weight
+    };
+
+    Kind kind;
+    VertexT u;
+    VertexT v;
+    WeightT weight;
+    WeightT previous;      // SetWeight only (equal to weight otherwise)
+    std::uint64_t version; // graph version right after this change
+};
+
+template <typename VertexT, typename WeightT>
+class ParallelGraphBuilder; // graph_builder.hpp
+
+template <typename VertexT = int, typename WeightT = int>
+class BasicGraph 
+{
+    friend class ParallelGraphBuilder<VertexT, WeightT>; // moves finished lists in without re-validating them
+
+public:
+    using VertexId = VertexT;
+    using Weight = WeightT;
+    using Edge = BasicGraphEdge<VertexT, WeightT>;
+    using Change = BasicGraphChange<VertexT, WeightT>;
+
+    /*
+    Neighbor and weight lists are pmr containers: they allocate from the memory resource passed to the
+    constructor (the default heap unless a caller passes one), so a server can build the graph of a request
+    in a per-request arena and drop it in one shot. The inner lists inherit the resource of the outer vector.
+    Copies of a graph allocate from the default resource (a copy may outlive the arena of its source);
+    moves keep the resource of the source.
+    */
+    using NeighborList = std::pmr::vector<VertexT>;
+    using WeightList = std::pmr::vector<WeightT>;
+    using AdjacencyLists = std::pmr::vector<NeighborList>;
+    using WeightLists = std::pmr::vector<WeightList>;
+
 private:
-    int V;  // number of vertices
-    int E;  // number of edges
+    VertexT V;  // number of vertices
+    std::size_t E;  // number of edges
     bool directed; // default is undirected
-    std::vector<std::vector<int>> adj; // adjacency list
-    std::vector<std::vector<int>> capacity; // capacity[u][v] = capacity of edge u->v
+    AdjacencyLists adj; // adjacency list
+    WeightLists weights; // weights[u][i] = capacity of edge u->adj[u][i]
+    EdgeIndex index; // optional O(1)/O(log deg) edge-existence index, see build_edge_index()
+    GraphFingerprint arcSum; // sum of graph_detail::arc_hash over every stored arc, see fingerprint()
+    std::uint64_t ver = 0; // +1 per mutation, see version()
+    bool logging = false; // record mutations in changeLog (off by default: a bulk load would double its memory)
+    std::uint64_t logStart = 0; // changeLog holds every change after this version
+    std::vector<Change> changeLog;
+
+    // Count one mutation (and log it when enabled)
+    void record(typename Change::Kind kind, VertexT u, VertexT v, WeightT w, WeightT previous);
 
 public:
 // Constructor:
@@ -33,36 +276,138 @@ public:
 The vertices number passed to adj creates a vector with empty vector lists,
 the size of the vertices we have(each vertex represent an empty list of its neighbors)
 */
-Graph(int vertices, bool isDirected) : 
-    V(vertices), E(0), directed(isDirected), adj(vertices), capacity(vertices, std::vector<int>(vertices, 0)) {
-        if (vertices <= 0) {
+BasicGraph(VertexT vertices, bool isDirected, std::pmr::memory_resource* resource = std::pmr::get_default_resource()) : 
+    V(vertices), E(0), directed(isDirected), adj(vertices, resource), weights(vertices, resource) {
+        if (graph_detail::is_negative(vertices) || vertices == 0) {
             throw std::invalid_argument("number of vertices must be positive");
         }
     }
 
+    /*
+    Build a graph directly from ready-made adjacency and weight lists (moved in, not copied).
+    edges is the logical edge count (an undirected edge counts once). Used by loaders/builders that
+    already produced the final per-vertex lists, e.g. the binary graph file reader.
+    The graph uses the memory resource of adjacency.
+    */
+    static BasicGraph fromAdjacency(VertexT vertices, bool isDirected, std::size_t edges,
+                                    AdjacencyLists&& adjacency, WeightLists&& weightLists);
+
     // Add edge (u -> v)
-    void addEdge(int u, int v, int cap = 1); // default capacity is 1 if not specified
+    void addEdge(VertexT u, VertexT v, WeightT cap = 1); // default capacity is 1 if not specified
+
+    /*
+    Bulk insert (same result as calling addEdge for each edge, in order):
+    *validates all edges in one pass first - on error nothing is added,
+    *counts the new degree of every vertex and reserves the exact capacity of each neighbor list,
+    *then appends, so no list reallocates while filling.
+    */
+    void addEdges(const Edge* edges, std::size_t count);
+    void addEdges(const std::vector<Edge>& edges) { addEdges(edges.data(), edges.size()); }
+
+    /*
+    Apply a duplicate-edge policy to the whole graph with one sort-and-unique pass over every neighbor list
+    (no per-edge searches), e.g. right after a bulk addEdges of an uploaded edge list.
+    Merging policies leave every list sorted by target; Reject only checks and leaves the graph untouched.
+    On an exception nothing is changed. Returns the number of edges removed.
+    */
+    std::size_t collapse_duplicate_edges(DuplicateEdgePolicy policy);
+
+    /*
+    Remove one edge u -> v (the first one in the list of u if there are parallel copies; in an undirected
+    graph the matching v -> u copy goes with it). Returns false if there is no such edge.
+    Neighbor order is kept, so this costs O(deg(u) + deg(v)).
+    */
+    bool removeEdge(VertexT u, VertexT v);
+
+    // Change the capacity of edge u -> v (first copy, like removeEdge). Returns false if there is no such edge.
+    bool setWeight(VertexT u, VertexT v, WeightT cap);
+
+    /*
+    Versioning: every addEdge/removeEdge/setWeight (and every edge of addEdges) increments version().
+    With the change log enabled, changes_since(v) returns the mutations made after version v, so a client
+    holding a result computed at version v can update it instead of recomputing it from scratch.
+    */
+    std::uint64_t version() const { return ver; }
+
+    // Start recording mutations from the current version on (false stops and drops the log)
+    void enable_change_log(bool on = true);
+
+    /*
+    Copy the changes made after version since into out (oldest first) and return true, or return false if
+    the log does not cover them: logging disabled, log trimmed past since, or a collapse_duplicate_edges
+    merge in between (merges are not logged edge by edge, they restart the log).
+    */
+    bool changes_since(std::uint64_t since, std::vector<Change>& out) const;
+
+    // Drop the logged changes up to version upTo (once every client has caught up with them)
+    void trim_change_log(std::uint64_t upTo);
 
 
     // Get number of vertices
-    int get_vertices() const { return V; }
+    VertexT get_vertices() const { return V; }
 
-    // Get number of edges
+    // Returns true if the graph is directed
+    bool is_directed() const { return directed; }
+
+    // Memory resource the neighbor/weight lists allocate from
+    std::pmr::memory_resource* get_memory_resource() const { return adj.get_allocator().resource(); }
 
     // Return the full adjacency list
-    const std::vector<std::vector<int>>& getAdjList() const { return adj; }
+    const AdjacencyLists& getAdjList() const { return adj; }
     
     // Get number of edges
-    int get_edges() const { return E; }
+    std::size_t get_edges() const { return E; }
 
     // Return adjacency list of a vertex
-    const std::vector<int>& get_neighbors(int u) const;
+    const NeighborList& get_neighbors(VertexT u) const;
+
+    // Return the full weight list (parallel to getAdjList())
+    const WeightLists& getWeightList() const { return weights; }
+
+    // Return the capacities of the edges leaving u (parallel to get_neighbors(u))
+    const WeightList& get_weights(VertexT u) const;
+
+    // f(target, weight) for every edge leaving u (same loop for Graph, CsrGraph and CompressedGraph)
+    template <typename F>
+    void for_each_arc(VertexT u, F&& f) const
+    {
+        const auto& neighbors = get_neighbors(u);
+        const auto& capacities = get_weights(u);
+        for (std::size_t i = 0; i < neighbors.size(); ++i)
+        {
+            f(neighbors[i], capacities[i]);
+        }
+    }
 
-    // Getter for capacity
-    const std::vector<std::vector<int>>& get_capacity() const { return capacity; }
+    // Capacity of edge u->v (0 if there is no such edge), served from the edge storage
+    WeightT get_capacity(VertexT u, VertexT v) const;
 
     // Returns true if there is an edge from u to v
-    bool is_edge(int u, int v) const;
+    bool is_edge(VertexT u, VertexT v) const;
+
+    /*
+    Build the edge-existence index used by is_edge (bit matrix for small/dense graphs,
+    sorted neighbor lists for large sparse ones - chosen from V and E).
+    In bit matrix mode addEdge keeps the index up to date, otherwise the next addEdge drops it
+    and is_edge falls back to scanning until the index is built again.
+    */
+    void build_edge_index();
+
+    // Returns true if is_edge is currently served by the index
+    bool has_edge_index() const { return index.ready(); }
+
+    const EdgeIndex& get_edge_index() const { return index; }
+
+    /*
+    Bytes currently held (allocated capacity, not just size: the slack left by addEdge growth counts).
+    estimate_memory gives the same figure before construction, for lists filled to exact size (what the
+    parallel builder and the loaders produce), so servers can refuse a request before allocating anything.
+    */
+    GraphMemoryUsage memory_usage() const;
+    static GraphMemoryUsage estimate_memory(VertexT vertices, std::size_t edges, bool isDirected);
+
+    // Content hash (vertices, directed flag, edge multiset), kept up to date by every edge insertion
+    GraphFingerprint fingerprint() const;
 
     // Print graph (for debugging)
     void print() const;
@@ -70,4 +415,15 @@ Graph(int vertices, bool isDirected) :
 
 };
 
+// The default graph: int vertex ids and int capacities
+using Graph = BasicGraph<int, int>;
+using GraphEdge = BasicGraphEdge<int, int>;
 
+/*
+Vertex-id / weight combinations compiled into graph_impl.cpp (and into the part_7 algorithms).
+X(VertexT, WeightT) is expanded once per combination; Graph is BasicGraph<int, std::int32_t>.
+*/
+#define GRAPH_FOR_EACH_TYPE(X) \
+    X(int, std::uint8_t) X(int, std::uint16_t) X(int, std::int32_t) X(int, std::int64_t) \
+    X(std::uint32_t, std::uint8_t) X(std::uint32_t, std::uint16_t) X(std::uint32_t, std::int32_t) X(std::uint32_t, std::int64_t) \
+    X(std::uint64_t, std::uint8_t) X(std::uint64_t, std::uint16_t) X(std::uint64_t, std::int32_t) X(std::uint64_t, std::int64_t)
@@ -0,0 +1,479 @@
+/*
+@ author: Roy Meoded
+@ author: Yarin Keshet
+
+@ description: Random graph families for benchmarks, besides the uniform G(n,m) of edge_sampling.hpp
+                (part_3/part_4 generate_model_graph, MODEL in the RANDOM requests of part_8/part_9):
+- R-MAT (Chakrabarti, Zhan & Faloutsos): every edge descends the adjacency matrix one quadrant per level with
+  probabilities a, b, c, d = 1-a-b-c, giving skewed degrees with hubs at small ids. Edge i is drawn from its
+  own position of a Philox stream, so the edges are drawn in parallel and do not depend on the thread count.
+  Self-loops are redrawn and repeated edges merged, so the graph has at most E edges.
+- Barabasi-Albert preferential attachment: vertices 0..m form a clique, every later vertex links to m distinct
+  earlier ones picked proportionally to their degree (a uniform pick from the list of all edge endpoints,
+  Batagelj & Brandes), O(V m). Sequential by nature.
+- 2D/3D grids: V vertices row-major in a square / cube of side ceil(V^(1/2)) / ceil(V^(1/3)) (the last row or
+  plane partial), every vertex linked to its next neighbor along each axis. E and the seed are not used.
+- Planted cliques: a uniform G(n,m) background of E edges plus `count` cliques of `size` random vertices.
+Directed graphs: R-MAT arcs keep their orientation, BA arcs go from the newer vertex to the older one, grid
+and clique edges get both directions.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "edge_sampling.hpp"
+#include "graph_impl.hpp"
+
+// Philox streams of the models, next to the THINNING / WEIGHT streams of edge_sampling.hpp
+constexpr std::uint64_t RMAT_STREAM = ~std::uint64_t(0) - 2;    // block position = edge number << 8
+constexpr std::uint64_t ATTACH_STREAM = ~std::uint64_t(0) - 3;  // Barabasi-Albert picks
+constexpr std::uint64_t CLIQUE_STREAM = ~std::uint64_t(0) - 4;  // planted clique vertices
+
+// Draws of one R-MAT edge before giving up: reachable pairs with a vanishing probability would otherwise spin forever
+constexpr int RMAT_MAX_TRIES = 1 << 16;
+
+struct GraphModel
+{
+    enum Kind { Uniform, RMat, PreferentialAttachment, Grid2D, Grid3D, PlantedCliques };
+
+    Kind kind = Uniform;
+    double a = 0.57, b = 0.19, c = 0.19;  // R-MAT quadrant probabilities (Graph500 defaults), d = 1 - a - b - c
+    int attach = 0;                       // Barabasi-Albert edges per new vertex, 0 = E / V (at least 1)
+    int clique_size = 0;                  // planted cliques: vertices per clique
+    int clique_count = 1;                 // planted cliques: number of cliques
+
+    // Edges per new vertex of a (V, E) Barabasi-Albert graph
+    int attach_for(int vertices, int edges) const
+    {
+        return attach > 0 ? attach : std::max(1, vertices > 0 ? edges / vertices : 1);
+    }
+
+    // Upper bound on the edges of a (V, E) graph of this model (memory estimates before generating)
+    std::uint64_t max_edges(int vertices, int edges, bool directed) const
+    {
+        const std::uint64_t pairs = pair_count(vertices, directed);
+        const std::uint64_t V = vertices > 0 ? static_cast<std::uint64_t>(vertices) : 0;
+        const std::uint64_t E = edges > 0 ? static_cast<std::uint64_t>(edges) : 0;
+        const std::uint64_t both = directed ? 2 : 1;
+        switch (kind)
+        {
+            case PreferentialAttachment:
+            {
+                std::uint64_t m = static_cast<std::uint64_t>(attach_for(vertices, edges));
+                return V <= m ? 0 : m * (m + 1) / 2 + (V - m - 1) * m;
+            }
+            case Grid2D: return 2 * V * both;
+            case Grid3D: return 3 * V * both;
+            case PlantedCliques:
+            {
+                std::uint64_t k = static_cast<std::uint64_t>(std::max(clique_size, 0));
+                return std::min(pairs, E + static_cast<std::uint64_t>(clique_count) * k * (k > 0 ? k - 1 : 0) / 2 * both);
+            }
+            default: return std::min(pairs, E);
+        }
+    }
+};
+
+/*
+Model from its text form, the same in the part_4 CLI (-m) and the MODEL protocol line (case-insensitive):
+"uniform" | "rmat[:a,b,c]" | "ba[:m]" | "grid2d" | "grid3d" | "cliques:size[,count]".
+Throws invalid_argument for an unknown name or bad parameters.
+*/
+inline GraphModel parse_graph_model(const std::string& spec)
+{
+    std::string name = spec.substr(0, spec.find(':'));
+    std::transform(name.begin(), name.end(), name.begin(), [](unsigned char ch) { return std::tolower(ch); });
+    std::vector<std::string> args;
+    if (spec.find(':') != std::string::npos)
+    {
+        std::string rest = spec.substr(spec.find(':') + 1);
+        std::size_t start = 0;
+        while (true)
+        {
+            std::size_t comma = rest.find(',', start);
+            args.push_back(rest.substr(start, comma - start));
+            if (comma == std::string::npos)
+            {
+                break;
+            }
+            start = comma + 1;
+        }
+    }
+    auto number = [&](std::size_t i)
+    {
+        std::size_t used = 0;
+        double value = 0;
+        try
+        {
+            value = std::stod(args[i], &used);
+        }
+        catch (const std::exception&)
+        {
+            used = 0;
+        }
+        if (used == 0 || used != args[i].size())
+        {
+            throw std::invalid_argument("bad model parameter '" + args[i] + "' in '" + spec + "'");
+        }
+        return value;
+    };
+    auto integer = [&](std::size_t i)
+    {
+        double value = number(i);
+        if (value != std::floor(value) || value < 0 || value > 1e9)
+        {
+            throw std::invalid_argument("model parameter '" + args[i] + "' must be a non-negative integer");
+        }
+        return static_cast<int>(value);
+    };
+    auto expect = [&](std::size_t most)
+    {
+        if (args.size() > most)
+        {
+            throw std::invalid_argument("too many parameters in model '" + spec + "'");
+        }
+    };
+
+    GraphModel model;
+    if (name == "uniform" || name == "er")
+    {
+        expect(0);
+    }
+    else if (name == "rmat")
+    {
+        expect(3);
+        model.kind = GraphModel::RMat;
+        if (!args.empty())
+        {
+            if (args.size() != 3)
+            {
+                throw std::invalid_argument("rmat takes the three probabilities a,b,c (d = 1 - a - b - c)");
+            }
+            model.a = number(0);
+            model.b = number(1);
+            model.c = number(2);
+        }
+        if (model.a < 0 || model.b < 0 || model.c < 0 || model.a + model.b + model.c > 1 + 1e-12 || model.b + model.c <= 0)
+        {
+            throw std::invalid_argument("rmat probabilities must be non-negative, sum to at most 1, with b + c > 0");
+        }
+    }
+    else if (name == "ba")
+    {
+        expect(1);
+        model.kind = GraphModel::PreferentialAttachment;
+        model.attach = args.empty() ? 0 : integer(0);
+    }
+    else if (name == "grid2d" || name == "grid3d")
+    {
+        expect(0);
+        model.kind = name == "grid2d" ? GraphModel::Grid2D : GraphModel::Grid3D;
+    }
+    else if (name == "cliques")
+    {
+        expect(2);
+        model.kind = GraphModel::PlantedCliques;
+        if (args.empty())
+        {
+            throw std::invalid_argument("cliques needs the clique size (cliques:size[,count])");
+        }
+        model.clique_size = integer(0);
+        model.clique_count = args.size() > 1 ? integer(1) : 1;
+        if (model.clique_size < 2 || model.clique_count < 1)
+        {
+            throw std::invalid_argument("planted cliques need a size of at least 2 and a count of at least 1");
+        }
+    }
+    else
+    {
+        throw std::invalid_argument("unknown graph model '" + spec + "' (uniform, rmat, ba, grid2d, grid3d, cliques)");
+    }
+    return model;
+}
+
+// Sorts the edges and merges repeated ones (undirected edges are stored as u < v first)
+inline void merge_repeated_edges(std::vector<GraphEdge>& edges, bool directed)
+{
+    if (!directed)
+    {
+        for (auto& e : edges)
+        {
+            if (e.u > e.v)
+            {
+                std::swap(e.u, e.v);
+            }
+        }
+    }
+    auto key = [](const GraphEdge& e) { return std::make_pair(e.u, e.v); };
+    std::sort(edges.begin(), edges.end(), [&](const GraphEdge& x, const GraphEdge& y) { return key(x) < key(y); });
+    edges.erase(std::unique(edges.begin(), edges.end(), [&](const GraphEdge& x, const GraphEdge& y) { return key(x) == key(y); }),
+                edges.end());
+}
+
+// Smallest s with s^dims >= n (side of the grid)
+inline std::uint64_t grid_side(std::uint64_t n, int dims)
+{
+    auto power = [dims](std::uint64_t s) { return dims == 2 ? s * s : s * s * s; };
+    std::uint64_t s = static_cast<std::uint64_t>(std::llround(std::pow(static_cast<double>(n), 1.0 / dims)));
+    while (power(s) < n)
+    {
+        ++s;
+    }
+    while (s > 1 && power(s - 1) >= n)
+    {
+        --s;
+    }
+    return std::max<std::uint64_t>(s, 1);
+}
+
+/*
+Whether R-MAT draws over `levels` bits can give an in-range pair u != v (u, v < V) when only the quadrants
+with allowed[q] (a, b, c, d = bit pairs 00, 01, 10, 11) have a non-zero threshold.
+Walks the bits from the top keeping, for u and v, whether the prefix still equals the prefix of V - 1,
+and whether u and v already differ: 8 states, O(levels).
+*/
+inline bool rmat_reaches_pair(const bool allowed[4], int levels, std::uint64_t vertices)
+{
+    const std::uint64_t limit = vertices - 1;
+    bool state[8] = {};        // index: tight u | tight v << 1 | differ << 2
+    state[1 | 2] = true;
+    for (int l = levels - 1; l >= 0; --l)
+    {
+        const int bound = static_cast<int>((limit >> l) & 1);
+        bool next[8] = {};
+        for (int st = 0; st < 8; ++st)
+        {
+            if (!state[st])
+            {
+                continue;
+            }
+            const bool tu = st & 1, tv = st & 2, differ = st & 4;
+            for (int q = 0; q < 4; ++q)
+            {
+                const int ub = q >> 1, vb = q & 1;
+                if (!allowed[q] || (tu && ub > bound) || (tv && vb > bound))
+                {
+                    continue;
+                }
+                next[(tu && ub == bound) | (tv && vb == bound) << 1 | (differ || ub != vb) << 2] = true;
+            }
+        }
+        std::copy(next, next + 8, state);
+    }
+    return state[4] || state[5] || state[6] || state[7];
+}
+
+/*
+Edges (weight 1) of a (V, E) graph of a model other than Uniform (that one is generate_random_graph),
+determined by the seed alone for every thread count. Throws invalid_argument for impossible parameters
+(a Barabasi-Albert graph needs more than m vertices, a clique cannot be larger than V,
+R-MAT probabilities must be able to give two different vertices below V).
+*/
+inline std::vector<GraphEdge> model_edges(const GraphModel& model, int vertices, int edges, bool directed,
+                                          std::uint64_t seed, unsigned threads = 0)
+{
+    if (vertices <= 0)
+    {
+        throw std::invalid_argument("number of vertices must be positive");
+    }
+    if (edges < 0)
+    {
+        throw std::invalid_argument("number of edges cannot be negative");
+    }
+    std::vector<GraphEdge> list;
+    auto both_ways = [&]()
+    {
+        if (directed)
+        {
+            std::size_t n = list.size();
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                list.push_back({list[i].v, list[i].u, 1});
+            }
+        }
+    };
+
+    switch (model.kind)
+    {
+        case GraphModel::RMat:
+        {
+            if (vertices < 2)
+            {
+                return list;
+            }
+            int levels = 1;
+            while ((std::uint64_t(1) << levels) < static_cast<std::uint64_t>(vertices))
+            {
+                ++levels;
+            }
+            // Quadrant thresholds on 32-bit draws: every 64-bit output decides two levels
+            const double scale = 4294967296.0;
+            const std::uint64_t ta = static_cast<std::uint64_t>(model.a * scale);
+            const std::uint64_t tab = static_cast<std::uint64_t>((model.a + model.b) * scale);
+            const std::uint64_t tabc = static_cast<std::uint64_t>((model.a + model.b + model.c) * scale);
+            const bool allowed[4] = {ta > 0, tab > ta, tabc > tab, tabc < static_cast<std::uint64_t>(scale)};
+            if (edges > 0 && !rmat_reaches_pair(allowed, levels, static_cast<std::uint64_t>(vertices)))
+            {
+                throw std::invalid_argument("rmat probabilities cannot give an edge between two different vertices below V = " +
+                                            std::to_string(vertices));
+            }
+            list.resize(static_cast<std::size_t>(edges));
+            const unsigned T = sample_threads(threads, sample_blocks(list.size(), static_cast<double>(list.size())));
+            run_on_threads(T, [&](unsigned t)
+            {
+                auto [first, last] = part_range(list.size(), T, t);
+                for (std::size_t i = first; i < last; ++i)
+                {
+                    PhiloxStream rng(seed, RMAT_STREAM, static_cast<std::uint64_t>(i) << 8);
+                    std::uint64_t u, v;
+                    int tries = 0;
+                    do
+                    {
+                        if (++tries > RMAT_MAX_TRIES)
+                        {
+                            throw std::invalid_argument("rmat probabilities almost never give an edge below V = " +
+                                                        std::to_string(vertices));
+                        }
+                        u = v = 0;
+                        std::uint64_t bits = 0;
+                        for (int l = 0; l < levels; ++l)
+                        {
+                            bits = (l % 2 == 0) ? rng() : bits >> 32;
+                            std::uint64_t r = bits & 0xFFFFFFFFu;
+                            u = (u << 1) | (r >= tab ? 1 : 0);
+                            v = (v << 1) | ((r >= ta && r < tab) || r >= tabc ? 1 : 0);
+                        }
+                    } while (u >= static_cast<std::uint64_t>(vertices) || v >= static_cast<std::uint64_t>(vertices) || u == v);
+                    list[i] = {static_cast<int>(u), static_cast<int>(v), 1};
+                }
+            });
+            merge_repeated_edges(list, directed);
+            break;
+        }
+        case GraphModel::PreferentialAttachment:
+        {
+            const int m = model.attach_for(vertices, edges);
+            if (vertices <= m)
+            {
+                throw std::invalid_argument("a Barabasi-Albert graph with m = " + std::to_string(m) +
+                                            " needs more than m vertices");
+            }
+            list.reserve(static_cast<std::size_t>(model.max_edges(vertices, edges, false)));
+            std::vector<int> endpoints; // every edge end once: a uniform pick is a degree-proportional vertex
+            endpoints.reserve(2 * list.capacity());
+            for (int u = 0; u <= m; ++u)
+            {
+                for (int v = 0; v < u; ++v)
+                {
+                    list.push_back({u, v, 1});
+                    endpoints.push_back(u);
+                    endpoints.push_back(v);
+                }
+            }
+            PhiloxStream rng(seed, ATTACH_STREAM);
+            std::vector<int> picks;
+            for (int u = m + 1; u < vertices; ++u)
+            {
+                picks.clear();
+                while (static_cast<int>(picks.size()) < m)
+                {
+                    int v = endpoints[uniform_below(endpoints.size(), rng)];
+                    if (std::find(picks.begin(), picks.end(), v) == picks.end())
+                    {
+                        picks.push_back(v);
+                    }
+                }
+                for (int v : picks)
+                {
+                    list.push_back({u, v, 1});
+                    endpoints.push_back(u);
+                    endpoints.push_back(v);
+                }
+            }
+            break;
+        }
+        case GraphModel::Grid2D:
+        case GraphModel::Grid3D:
+        {
+            const int dims = model.kind == GraphModel::Grid2D ? 2 : 3;
+            const std::uint64_t n = static_cast<std::uint64_t>(vertices);
+            const std::uint64_t s = grid_side(n, dims);
+            list.reserve(static_cast<std::size_t>(model.max_edges(vertices, edges, directed)));
+            for (std::uint64_t i = 0; i < n; ++i)
+            {
+                const int u = static_cast<int>(i);
+                if (i % s + 1 < s && i + 1 < n)
+                {
+                    list.push_back({u, static_cast<int>(i + 1), 1});
+                }
+                if ((dims == 2 || i / s % s + 1 < s) && i + s < n)
+                {
+                    list.push_back({u, static_cast<int>(i + s), 1});
+                }
+                if (dims == 3 && i + s * s < n)
+                {
+                    list.push_back({u, static_cast<int>(i + s * s), 1});
+                }
+            }
+            both_ways();
+            break;
+        }
+        case GraphModel::PlantedCliques:
+        {
+            const int k = model.clique_size;
+            if (k > vertices)
+            {
+                throw std::invalid_argument("a planted clique cannot have more than V vertices");
+            }
+            if (static_cast<std::uint64_t>(edges) > pair_count(vertices, directed))
+            {
+                throw std::invalid_argument("number of edges must be between 0 and the number of vertex pairs");
+            }
+            std::vector<std::uint64_t> picked = parallel_sample_indices(pair_count(vertices, directed), edges, seed, threads);
+            list.resize(picked.size());
+            parallel_decode(picked, vertices, directed, threads, [&](std::size_t i, int u, int v) { list[i] = {u, v, 1}; });
+            std::vector<std::uint64_t>().swap(picked);
+
+            PhiloxStream rng(seed, CLIQUE_STREAM);
+            std::vector<char> taken(static_cast<std::size_t>(vertices), 0);
+            std::vector<int> members;
+            for (int q = 0; q < model.clique_count; ++q)
+            {
+                members.clear();
+                while (static_cast<int>(members.size()) < k)
+                {
+                    int v = static_cast<int>(uniform_below(static_cast<std::uint64_t>(vertices), rng));
+                    if (!taken[v])
+                    {
+                        taken[v] = 1;
+                        members.push_back(v);
+                    }
+                }
+                for (std::size_t x = 0; x < members.size(); ++x)
+                {
+                    taken[members[x]] = 0;
+                    for (std::size_t y = 0; y < x; ++y)
+                    {
+                        list.push_back({members[x], members[y], 1});
+                        if (directed)
+                        {
+                            list.push_back({members[y], members[x], 1});
+                        }
+                    }
+                }
+            }
+            merge_repeated_edges(list, directed);
+            break;
+        }
+        default:
+            throw std::invalid_argument("the uniform model is drawn by generate_random_graph");
+    }
+    return list;
+}
@@ -0,0 +1,191 @@
+#include "graph_reorder.hpp"
+
+#include <numeric>
+#include <utility>
+
+// Out-degree + in-degree of every vertex (for undirected graphs both are the list size, the order is the same)
+template <typename VertexT, typename WeightT>
+static std::vector<std::size_t> total_degrees(const BasicGraph<VertexT, WeightT>& g)
+{
+    const VertexT n = g.get_vertices();
+    std::vector<std::size_t> deg(n, 0);
+    for (VertexT u = 0; u < n; ++u)
+    {
+        const auto& neighbors = g.get_neighbors(u);
+        deg[u] += neighbors.size();
+        if (g.is_directed())
+        {
+            for (VertexT v : neighbors)
+            {
+                ++deg[v];
+            }
+        }
+    }
+    return deg;
+}
+
+/*
+Reverse Cuthill-McKee on the undirected view of the graph (an arc in either direction connects two vertices):
+1. Pick the unvisited vertex with the smallest degree as the start of the next component.
+2. BFS from it; the neighbors of every dequeued vertex are appended in increasing degree order.
+3. Reverse the whole visit order.
+*/
+template <typename VertexT, typename WeightT>
+static std::vector<VertexT> rcm_order(const BasicGraph<VertexT, WeightT>& g, const std::vector<std::size_t>& deg)
+{
+    const VertexT n = g.get_vertices();
+
+    // Undirected view for directed graphs: in-arcs in CSR form
+    std::vector<std::size_t> inStart;
+    std::vector<VertexT> inArcs;
+    if (g.is_directed())
+    {
+        inStart.assign(static_cast<std::size_t>(n) + 1, 0);
+        for (VertexT u = 0; u < n; ++u)
+        {
+            for (VertexT v : g.get_neighbors(u))
+            {
+                ++inStart[v + 1];
+            }
+        }
+        for (VertexT u = 0; u < n; ++u)
+        {
+            inStart[u + 1] += inStart[u];
+        }
+        inArcs.resize(inStart[n]);
+        std::vector<std::size_t> cursor(inStart.begin(), inStart.end() - 1);
+        for (VertexT u = 0; u < n; ++u)
+        {
+            for (VertexT v : g.get_neighbors(u))
+            {
+                inArcs[cursor[v]++] = u;
+            }
+        }
+    }
+
+    std::vector<VertexT> byDegree(n);
+    std::iota(byDegree.begin(), byDegree.end(), VertexT(0));
+    std::stable_sort(byDegree.begin(), byDegree.end(), [&](VertexT a, VertexT b) { return deg[a] < deg[b]; });
+
+    std::vector<char> visited(n, 0);
+    std::vector<VertexT> order;
+    order.reserve(n);
+    std::vector<VertexT> next; // neighbors of the current vertex, sorted by degree before they are appended
+    for (VertexT root : byDegree)
+    {
+        if (visited[root])
+        {
+            continue;
+        }
+        visited[root] = 1;
+        std::size_t head = order.size();
+        order.push_back(root);
+        while (head < order.size())
+        {
+            VertexT u = order[head++];
+            next.clear();
+            for (VertexT v : g.get_neighbors(u))
+            {
+                if (!visited[v])
+                {
+                    visited[v] = 1;
+                    next.push_back(v);
+                }
+            }
+            if (g.is_directed())
+            {
+                for (std::size_t a = inStart[u]; a < inStart[u + 1]; ++a)
+                {
+                    VertexT v = inArcs[a];
+                    if (!visited[v])
+                    {
+                        visited[v] = 1;
+                        next.push_back(v);
+                    }
+                }
+            }
+            std::stable_sort(next.begin(), next.end(), [&](VertexT a, VertexT b) { return deg[a] < deg[b]; });
+            order.insert(order.end(), next.begin(), next.end());
+        }
+    }
+    std::reverse(order.begin(), order.end());
+    return order;
+}
+
+template <typename VertexT, typename WeightT>
+std::vector<VertexT> compute_vertex_order(const BasicGraph<VertexT, WeightT>& g, VertexOrdering how)
+{
+    const VertexT n = g.get_vertices();
+    std::vector<std::size_t> deg = total_degrees(g);
+
+    std::vector<VertexT> order; // order[new] = old
+    if (how == VertexOrdering::DEGREE)
+    {
+        order.resize(n);
+        std::iota(order.begin(), order.end(), VertexT(0));
+        std::stable_sort(order.begin(), order.end(), [&](VertexT a, VertexT b) { return deg[a] > deg[b]; });
+    }
+    else
+    {
+        order = rcm_order(g, deg);
+    }
+
+    std::vector<VertexT> newId(n);
+    for (VertexT i = 0; i < n; ++i)
+    {
+        newId[order[i]] = i;
+    }
+    return newId;
+}
+
+template <typename VertexT, typename WeightT>
+BasicGraph<VertexT, WeightT> permute_graph(const BasicGraph<VertexT, WeightT>& g, const std::vector<VertexT>& newId)
+{
+    const VertexT n = g.get_vertices();
+    if (newId.size() != static_cast<std::size_t>(n))
+    {
+        throw std::invalid_argument("permutation size does not match the number of vertices");
+    }
+
+    typename BasicGraph<VertexT, WeightT>::AdjacencyLists adj(n, g.get_memory_resource()); // same resource as g
+    typename BasicGraph<VertexT, WeightT>::WeightLists wts(n, g.get_memory_resource());
+    std::vector<std::pair<VertexT, WeightT>> list; // one relabeled neighbor list, sorted before it is stored
+    for (VertexT u = 0; u < n; ++u)
+    {
+        const auto& neighbors = g.get_neighbors(u);
+        const auto& weights = g.get_weights(u);
+        list.clear();
+        for (std::size_t i = 0; i < neighbors.size(); ++i)
+        {
+            list.push_back({newId[neighbors[i]], weights[i]});
+        }
+        std::stable_sort(list.begin(), list.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+        VertexT nu = newId[u];
+        adj[nu].reserve(list.size());
+        wts[nu].reserve(list.size());
+        for (const auto& [v, w] : list)
+        {
+            adj[nu].push_back(v);
+            wts[nu].push_back(w);
+        }
+    }
+    return BasicGraph<VertexT, WeightT>::fromAdjacency(n, g.is_directed(), g.get_edges(), std::move(adj), std::move(wts));
+}
+
+template <typename VertexT, typename WeightT>
+ReorderedGraph<VertexT, WeightT>::ReorderedGraph(const BasicGraph<VertexT, WeightT>& g, VertexOrdering how) :
+    newIds(compute_vertex_order(g, how)), oldIds(newIds.size()), permuted(permute_graph(g, newIds))
+{
+    for (std::size_t i = 0; i < newIds.size(); ++i)
+    {
+        oldIds[newIds[i]] = static_cast<VertexT>(i);
+    }
+}
+
+#define INSTANTIATE_REORDER(VertexT, WeightT) \
+    template std::vector<VertexT> compute_vertex_order<VertexT, WeightT>(const BasicGraph<VertexT, WeightT>&, VertexOrdering); \
+    template BasicGraph<VertexT, WeightT> permute_graph<VertexT, WeightT>(const BasicGraph<VertexT, WeightT>&, const std::vector<VertexT>&); \
+    template class ReorderedGraph<VertexT, WeightT>;
+GRAPH_FOR_EACH_TYPE(INSTANTIATE_REORDER)
+#undef INSTANTIATE_REORDER
@@ -0,0 +1,57 @@
+/*
+@ author: Roy Meoded
+@ author: Yarin Keshet
+
+@ description: Vertex relabeling for cache locality.
+                Generated and uploaded graphs have arbitrary vertex numbers, so a BFS/DFS jumps around
+                the adjacency lists and visited/parent arrays in random order. A relabeling pass gives vertices
+                that are visited together nearby ids:
+                - DEGREE: vertices sorted by decreasing degree (hubs, which are touched most often, share cache lines).
+                - RCM: reverse Cuthill-McKee, a BFS from a low-degree vertex of every component, neighbors taken
+                  in increasing degree order, then reversed. Keeps the ids of adjacent vertices close (small bandwidth).
+                ReorderedGraph holds the permuted graph plus both directions of the permutation; the part_7
+                algorithms accept it directly, translate their inputs to new ids and map results back to the
+                original ids, so the caller never sees the new numbering.
+*/
+
+#pragma once
+
+#include <vector>
+
+#include "graph_impl.hpp"
+
+enum class VertexOrdering
+{
+    DEGREE, // decreasing degree
+    RCM     // reverse Cuthill-McKee
+};
+
+// newId[old] for every vertex of g (a permutation of 0..V-1)
+template <typename VertexT, typename WeightT>
+std::vector<VertexT> compute_vertex_order(const BasicGraph<VertexT, WeightT>& g, VertexOrdering how);
+
+// Relabel g: vertex u becomes newId[u], every neighbor list is sorted by the new ids (weights follow their edge)
+template <typename VertexT, typename WeightT>
+BasicGraph<VertexT, WeightT> permute_graph(const BasicGraph<VertexT, WeightT>& g, const std::vector<VertexT>& newId);
+
+template <typename VertexT, typename WeightT>
+class ReorderedGraph
+{
+public:
+    ReorderedGraph(const BasicGraph<VertexT, WeightT>& g, VertexOrdering how);
+
+    // The relabeled graph (algorithms run on this one)
+    const BasicGraph<VertexT, WeightT>& graph() const { return permuted; }
+
+    // Original id -> new id, and back
+    VertexT to_new(VertexT oldId) const { return newIds.at(oldId); }
+    VertexT to_old(VertexT newId) const { return oldIds.at(newId); }
+
+    const std::vector<VertexT>& new_ids() const { return newIds; }
+    const std::vector<VertexT>& old_ids() const { return oldIds; }
+
+private:
+    std::vector<VertexT> newIds; // newIds[old] = new
+    std::vector<VertexT> oldIds; // oldIds[new] = old
+    BasicGraph<VertexT, WeightT> permuted;
+};
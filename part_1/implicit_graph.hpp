@@ -0,0 +1,366 @@
+/*
+@ author: Roy Meoded
+@ author: Yarin Keshet
+
+@ description: Implicit random graph for graphs too large to store (capacity planning):
+                every neighbor list is computed on demand from (seed, vertex) and nothing is stored per edge,
+                so an algorithm that keeps O(V) state of its own traverses a 10^8-edge graph in O(V) memory.
+                The edges come from keyed pseudo-random permutations pi_0, pi_1, ... of the vertex ids:
+                - permutation k links every vertex u below its limit to pi_k(u): the first E / V permutations
+                  cover every vertex, the last one the vertices u < E % V, so there are exactly E edges
+                  (arcs when directed);
+                - the list of u holds pi_k(u) (when u is below the limit) and, for an undirected graph,
+                  pi_k^-1(u) (when that vertex is): the inverse costs the same as the forward permutation, so
+                  the lists agree with each other without being stored. For a directed graph the pi_k^-1(u)
+                  entries are the arcs entering u (in_arcs), which is what Kosaraju needs instead of a transpose.
+                - the weight of edge (k, u -> pi_k(u)) is a hash of (seed, k, u) in [wmin, wmax].
+                This is the permutation model of random regular graphs (degree about 2E/V, E/V out-arcs when
+                directed), not G(n, m): a fixed point of a permutation is a self-loop and two permutations may
+                pick the same pair; both are rare (about one per permutation) and kept, so E is exact.
+                The interface mirrors CompressedGraph (get_neighbors / arcs / for_each_arc with forward
+                iterators); to_graph() materializes a small instance to check results against Graph.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "graph_impl.hpp"
+
+/*
+Keyed bijection of [0, n) and its inverse: a 4-round Feistel network over the smallest even number of bits that
+holds n - 1, cycle-walked back into [0, n) (the network's domain is less than 4n, so a few steps on average).
+*/
+class FeistelPermutation
+{
+public:
+    FeistelPermutation(std::uint64_t n, std::uint64_t key) : n(n)
+    {
+        int bits = 0;
+        while (bits < 63 && (std::uint64_t(1) << bits) < n)
+        {
+            ++bits;
+        }
+        half = bits > 1 ? (bits + 1) / 2 : 1;
+        mask = (std::uint64_t(1) << half) - 1;
+        for (int r = 0; r < ROUNDS; ++r)
+        {
+            keys[r] = graph_detail::mix64(key + 0x9e3779b97f4a7c15ULL * static_cast<std::uint64_t>(r + 1));
+        }
+    }
+
+    std::uint64_t operator()(std::uint64_t x) const
+    {
+        do
+        {
+            x = encrypt(x);
+        } while (x >= n);
+        return x;
+    }
+
+    std::uint64_t inverse(std::uint64_t y) const
+    {
+        do
+        {
+            y = decrypt(y);
+        } while (y >= n);
+        return y;
+    }
+
+private:
+    static constexpr int ROUNDS = 4;
+
+    std::uint64_t n;
+    int half;
+    std::uint64_t mask;
+    std::uint64_t keys[ROUNDS];
+
+    std::uint64_t round(int r, std::uint64_t x) const { return graph_detail::mix64(x ^ keys[r]) & mask; }
+
+    // (L, R) -> (R, L ^ F(R)) every round
+    std::uint64_t encrypt(std::uint64_t x) const
+    {
+        std::uint64_t L = x >> half, R = x & mask;
+        for (int r = 0; r < ROUNDS; ++r)
+        {
+            std::uint64_t t = L ^ round(r, R);
+            L = R;
+            R = t;
+        }
+        return (L << half) | R;
+    }
+
+    // The rounds undone in reverse order: (L, R) -> (R ^ F(L), L)
+    std::uint64_t decrypt(std::uint64_t y) const
+    {
+        std::uint64_t L = y >> half, R = y & mask;
+        for (int r = ROUNDS - 1; r >= 0; --r)
+        {
+            std::uint64_t t = R ^ round(r, L);
+            R = L;
+            L = t;
+        }
+        return (L << half) | R;
+    }
+};
+
+class ImplicitGraph
+{
+public:
+    using VertexId = std::uint32_t;
+
+    struct Arc
+    {
+        VertexId target;
+        int weight;
+    };
+
+    // Which entries of a list: pi_k(u) (Out), pi_k^-1(u) (In) or both (the lists of an undirected graph)
+    enum class Entries { Out, In, Both };
+
+    // Slot 2k of a list is pi_k(u), slot 2k+1 is pi_k^-1(u); END is past the last slot
+    static constexpr std::uint32_t END = ~std::uint32_t(0);
+
+    // Computes one list: yields Arc values front to back, skipping the slots the list does not have
+    class ArcIterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Arc;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Arc*;
+        using reference = const Arc&;
+
+        ArcIterator() = default;
+        ArcIterator(const ImplicitGraph* g, VertexId u, Entries entries) : g(g), u(u), entries(entries)
+        {
+            slot = g->next_arc(u, 0, entries, current);
+        }
+
+        const Arc& operator*() const { return current; }
+        const Arc* operator->() const { return &current; }
+        ArcIterator& operator++() { slot = g->next_arc(u, slot + 1, entries, current); return *this; }
+        bool operator==(const ArcIterator& other) const { return slot == other.slot; }
+        bool operator!=(const ArcIterator& other) const { return slot != other.slot; }
+
+    private:
+        const ImplicitGraph* g = nullptr;
+        VertexId u = 0;
+        Entries entries = Entries::Out;
+        std::uint32_t slot = END;
+        Arc current{0, 0};
+    };
+
+    // Same list, yields only the targets
+    class NeighborIterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = VertexId;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const VertexId*;
+        using reference = VertexId;
+
+        NeighborIterator() = default;
+        explicit NeighborIterator(ArcIterator it) : arc(it) {}
+
+        VertexId operator*() const { return arc->target; }
+        NeighborIterator& operator++() { ++arc; return *this; }
+        bool operator==(const NeighborIterator& other) const { return arc == other.arc; }
+        bool operator!=(const NeighborIterator& other) const { return arc != other.arc; }
+
+    private:
+        ArcIterator arc;
+    };
+
+    // A computed list; size() walks it
+    template <typename It>
+    struct Range
+    {
+        It first;
+        It last;
+
+        It begin() const { return first; }
+        It end() const { return last; }
+        std::size_t size() const { return static_cast<std::size_t>(std::distance(first, last)); }
+        bool empty() const { return first == last; }
+    };
+
+    /*
+    V vertices and exactly E edges (arcs when directed) drawn from the seed, weights in [wmin, wmax]
+    (wmin is normalized to at least 1, like the generators). Throws invalid_argument for V <= 0.
+    */
+    ImplicitGraph(int vertices, std::uint64_t edges, std::uint64_t seed, bool isDirected, int wmin = 1, int wmax = 1)
+        : V(vertices), E(edges), directed(isDirected)
+    {
+        if (vertices <= 0)
+        {
+            throw std::invalid_argument("number of vertices must be positive");
+        }
+        if (wmin > wmax)
+        {
+            std::swap(wmin, wmax);
+        }
+        wmin = std::max(wmin, 1);
+        wmax = std::max(wmax, wmin);
+        wbase = wmin;
+        wspan = static_cast<std::uint64_t>(wmax) - static_cast<std::uint64_t>(wmin) + 1;
+        weightKey = graph_detail::mix64(seed ^ 0x3c6ef372fe94f82bULL);
+        const std::uint64_t n = static_cast<std::uint64_t>(V);
+        rest = E % n;
+        const std::uint64_t count = E / n + (rest > 0 ? 1 : 0);
+        perms.reserve(static_cast<std::size_t>(count));
+        for (std::uint64_t k = 0; k < count; ++k)
+        {
+            perms.emplace_back(n, graph_detail::mix64(seed + 0xa54ff53a5f1d36f1ULL * (k + 1)));
+        }
+    }
+
+    int get_vertices() const { return V; }
+    std::size_t get_edges() const { return static_cast<std::size_t>(E); }
+    bool is_directed() const { return directed; }
+
+    // Arcs leaving u (computed, so O(E / V) work)
+    Range<ArcIterator> arcs(int u) const
+    {
+        check_vertex(u);
+        return {ArcIterator(this, static_cast<VertexId>(u), list_entries()), ArcIterator()};
+    }
+
+    Range<NeighborIterator> get_neighbors(int u) const
+    {
+        Range<ArcIterator> r = arcs(u);
+        return {NeighborIterator(r.first), NeighborIterator(r.last)};
+    }
+
+    // Arcs entering u, as (source, weight): the lists themselves for an undirected graph
+    Range<ArcIterator> in_arcs(int u) const
+    {
+        check_vertex(u);
+        return {ArcIterator(this, static_cast<VertexId>(u), directed ? Entries::In : Entries::Both), ArcIterator()};
+    }
+
+    // f(target, weight) for every arc leaving u
+    template <typename F>
+    void for_each_arc(int u, F&& f) const
+    {
+        for (const Arc& a : arcs(u))
+        {
+            f(a.target, a.weight);
+        }
+    }
+
+    int degree(int u) const { return static_cast<int>(arcs(u).size()); }
+
+    // Returns true if there is an edge from u to v: O(E / V) permutation evaluations
+    bool is_edge(int u, int v) const
+    {
+        check_vertex(u);
+        check_vertex(v);
+        for (std::size_t k = 0; k < perms.size(); ++k)
+        {
+            const std::uint64_t limit = limit_of(k);
+            if (static_cast<std::uint64_t>(u) < limit && perms[k](static_cast<std::uint64_t>(u)) == static_cast<std::uint64_t>(v))
+            {
+                return true;
+            }
+            if (!directed && static_cast<std::uint64_t>(v) < limit && perms[k](static_cast<std::uint64_t>(v)) == static_cast<std::uint64_t>(u))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /*
+    The first entry of the list of u at or after `slot` that the list has (see Entries): written to arc, its slot
+    returned, END when there is none. The iterators are built on it; an algorithm can also keep just (u, slot)
+    per vertex on its own stack instead of a whole iterator.
+    */
+    std::uint32_t next_arc(VertexId u, std::uint32_t slot, Entries entries, Arc& arc) const
+    {
+        const std::uint64_t x = static_cast<std::uint64_t>(u);
+        for (; slot < 2 * perms.size(); ++slot)
+        {
+            const std::size_t k = slot / 2;
+            if (slot % 2 == 0)
+            {
+                if (entries != Entries::In && x < limit_of(k))
+                {
+                    arc = {static_cast<VertexId>(perms[k](x)), weight(k, x)};
+                    return slot;
+                }
+            }
+            else if (entries != Entries::Out)
+            {
+                const std::uint64_t source = perms[k].inverse(x);
+                if (source < limit_of(k))
+                {
+                    arc = {static_cast<VertexId>(source), weight(k, source)};
+                    return slot;
+                }
+            }
+        }
+        return END;
+    }
+
+    // Entries of the lists of this graph
+    Entries list_entries() const { return directed ? Entries::Out : Entries::Both; }
+
+    // Bytes held: the permutation keys, nothing per vertex or edge
+    std::size_t memory_bytes() const { return sizeof(*this) + perms.capacity() * sizeof(FeistelPermutation); }
+
+    // The same edges stored in a Graph (for small instances: checks against the regular algorithms)
+    Graph to_graph() const
+    {
+        std::vector<GraphEdge> list;
+        list.reserve(static_cast<std::size_t>(E));
+        for (std::size_t k = 0; k < perms.size(); ++k)
+        {
+            for (std::uint64_t u = 0; u < limit_of(k); ++u)
+            {
+                list.push_back({static_cast<int>(u), static_cast<int>(perms[k](u)), weight(k, u)});
+            }
+        }
+        Graph g(V, directed);
+        g.addEdges(list);
+        return g;
+    }
+
+private:
+    int V;
+    std::uint64_t E;
+    bool directed;
+    std::uint64_t rest;                     // vertices linked by the last permutation (0: it is full too)
+    std::vector<FeistelPermutation> perms;  // pi_0 .. pi_{ceil(E / V) - 1}
+    std::uint64_t weightKey;
+    int wbase;
+    std::uint64_t wspan;
+
+    // Vertices u < limit are linked by permutation k
+    std::uint64_t limit_of(std::size_t k) const
+    {
+        return rest > 0 && k + 1 == perms.size() ? rest : static_cast<std::uint64_t>(V);
+    }
+
+    // Weight of edge (k, u -> pi_k(u)): the top 32 bits of a hash scaled to the span
+    int weight(std::size_t k, std::uint64_t u) const
+    {
+        std::uint64_t h = graph_detail::mix64(weightKey ^ graph_detail::mix64((static_cast<std::uint64_t>(k) << 32) ^ u));
+        return wbase + static_cast<int>(((h >> 32) * wspan) >> 32);
+    }
+
+    void check_vertex(int u) const
+    {
+        if (u < 0 || u >= V)
+        {
+            throw std::out_of_range("Vertex index out of range");
+        }
+    }
+};
@@ -1,5 +1,12 @@
 #include <iostream>
+#include <memory_resource>
 #include "graph_impl.hpp"
+#include "csr_graph.hpp"
+#include "shared_graph.hpp"
+#include "graph_file.hpp"
+#include "graph_reorder.hpp"
+#include "compressed_graph.hpp"
+#include "graph_builder.hpp"
 
 int main() 
 {
@@ -34,12 +41,19 @@ int main()
     std::cout << "Vertices: " << g.get_vertices() << std::endl;
     std::cout << "Edges: " << g.get_edges() << std::endl;
     (void)g.getAdjList();
-    (void)g.get_capacity();
+    std::cout << "capacity(0,1): " << g.get_capacity(0, 1) << std::endl;
 
     // Test is_edge function
     std::cout << "is_edge(0,1): " << g.is_edge(0,1) << std::endl;
     std::cout << "is_edge(2,4): " << g.is_edge(2,4) << std::endl;
 
+    // Same lookups through the edge index (bit matrix for such a small graph),
+    // and an edge added after the index was built:
+    g.build_edge_index();
+    g.addEdge(2, 4);
+    std::cout << "indexed is_edge(0,1): " << g.is_edge(0,1) << ", is_edge(4,2): " << g.is_edge(4,2)
+              << ", is_edge(1,3): " << g.is_edge(1,3) << std::endl;
+
     // ===== Directed graph =====
     Graph d(3, true);
 
@@ -58,7 +72,8 @@ int main()
     std::cout << "Directed Vertices: " << d.get_vertices() << std::endl;
     std::cout << "Directed Edges: " << d.get_edges() << std::endl;
     (void)d.getAdjList();
-    (void)d.get_capacity();
+    std::cout << "capacity(0,1): " << d.get_capacity(0, 1) << std::endl;
+    std::cout << "capacity(1,0): " << d.get_capacity(1, 0) << std::endl;
 
     // Test is_edge for directed graph
     std::cout << "is_edge(1,2): " << d.is_edge(1,2) << std::endl;
@@ -68,5 +83,224 @@ int main()
     std::cout << "Directed graph adjacency list:\n";
     d.print();
 
+    // ===== Bulk insert =====
+    Graph bulkGraph(4, false);
+    bulkGraph.addEdges({{0, 1, 2}, {1, 2, 3}, {2, 3}});
+    std::cout << "Bulk edges: " << bulkGraph.get_edges() << ", capacity(2,1): " << bulkGraph.get_capacity(2, 1) << std::endl;
+
+    // One invalid edge rejects the whole batch (should throw out_of_range, nothing is added)
+    try {
+        bulkGraph.addEdges({{0, 3, 1}, {0, 9, 1}});
+    } catch (const std::out_of_range& e) {
+        std::cout << "Caught exception: " << e.what() << ", edges still: " << bulkGraph.get_edges() << std::endl;
+    }
+
+    // ===== CSR graph =====
+    // Frozen from the directed graph above (same neighbor order):
+    CsrGraph frozen(d);
+    std::cout << "CSR (frozen) adjacency list:\n";
+    frozen.print();
+    std::cout << "CSR degree(0): " << frozen.degree(0) << std::endl;
+    std::cout << "CSR is_edge(0,1): " << frozen.is_edge(0, 1) << std::endl;
+
+    // Bulk-built from an edge list (undirected: both directions are stored)
+    CsrGraph bulk(4, false, {{0, 1, 2}, {1, 2, 3}, {2, 3}});
+    std::cout << "CSR (edge list) adjacency list:\n";
+    bulk.print();
+    std::cout << "CSR edges: " << bulk.get_edges() << ", weight(2->3): " << bulk.get_weights(2)[1] << std::endl;
+
+    // Invalid edge in the edge list (should throw out_of_range)
+    try {
+        CsrGraph bad(2, true, {{0, 5, 1}});
+    } catch (const std::out_of_range& e) {
+        std::cout << "Caught exception: " << e.what() << std::endl;
+    }
+
+    // ===== Shared snapshots (copy-on-write) =====
+    SharedGraph shared(Graph(3, false));
+    shared.write().addEdge(0, 1);          // sole owner: no copy
+    GraphSnapshot before = shared.snapshot();
+    shared.write().addEdge(1, 2);          // snapshot alive: the graph is cloned first
+    std::cout << "Snapshot edges: " << before->get_edges() << ", current edges: " << shared.read().get_edges() << std::endl;
+
+    // ===== Binary graph file (mmap) =====
+    save_graph_binary(d, "main_case2.graph");
+    MappedGraph mapped("main_case2.graph");
+    std::cout << "Mapped adjacency list (directed: " << mapped.is_directed() << "):\n";
+    mapped.print();
+    Graph reloaded = mapped.to_graph();
+    std::cout << "Reloaded edges: " << reloaded.get_edges() << ", capacity(0,1): " << reloaded.get_capacity(0, 1) << std::endl;
+
+    // Not a graph file (should throw runtime_error)
+    try {
+        MappedGraph bad("makefile");
+    } catch (const std::runtime_error& e) {
+        std::cout << "Caught exception: " << e.what() << std::endl;
+    }
+
+    // ===== Vertex reordering =====
+    // A path 0-3-1-4-2 with scrambled ids: RCM gives consecutive vertices consecutive ids
+    Graph path(5, false);
+    path.addEdges({{0, 3}, {3, 1}, {1, 4}, {4, 2}});
+    ReorderedGraph<int, int> rcm(path, VertexOrdering::RCM);
+    std::cout << "RCM new ids:";
+    for (int v = 0; v < 5; ++v) std::cout << " " << v << "->" << rcm.to_new(v);
+    std::cout << "\nRCM adjacency list:\n";
+    rcm.graph().print();
+
+    // ===== Compressed adjacency =====
+    // Lists are stored sorted, as varint deltas: 0->3 was added first but is listed last
+    Graph unsorted(4, true);
+    unsorted.addEdges({{0, 3, 7}, {0, 1, 2}, {0, 2, 300}, {2, 0, 4}});
+    CompressedGraph packed(unsorted);
+    std::cout << "Compressed adjacency list:\n";
+    packed.print();
+    std::cout << "Compressed degree(0): " << packed.degree(0) << ", is_edge(0,2): " << packed.is_edge(0, 2)
+              << ", is_edge(2,0): " << packed.is_edge(2, 0) << std::endl;
+    for (const auto& arc : packed.arcs(0)) std::cout << "Compressed arc 0->" << arc.target << " weight " << arc.weight << std::endl;
+
+    // A 100x100 grid: ~2.5 bytes per arc against two vectors of 4-byte entries per vertex
+    const int side = 100;
+    Graph grid(side * side, false);
+    std::vector<GraphEdge> gridEdges;
+    for (int r = 0; r < side; ++r)
+        for (int c = 0; c < side; ++c)
+        {
+            if (c + 1 < side) gridEdges.push_back({r * side + c, r * side + c + 1});
+            if (r + 1 < side) gridEdges.push_back({r * side + c, (r + 1) * side + c});
+        }
+    grid.addEdges(gridEdges);
+    std::size_t plainBytes = 0;
+    for (int u = 0; u < grid.get_vertices(); ++u)
+        plainBytes += 2 * sizeof(std::vector<int>) + grid.get_neighbors(u).capacity() * sizeof(int) + grid.get_weights(u).capacity() * sizeof(int);
+    CompressedGraph packedGrid(grid);
+    std::cout << "Grid lists: " << plainBytes << " bytes, compressed: " << packedGrid.memory_bytes() << " bytes" << std::endl;
+
+    // The same grid encoded while its (u, v)-sorted edges stream in, without a Graph
+    CompressedGraph::Builder builder;
+    builder.begin(side * side, false, gridEdges.size());
+    builder.consume(gridEdges.data(), gridEdges.size());
+    builder.finish();
+    CompressedGraph streamedGrid = builder.take();
+    bool sameArcs = true;
+    for (int u = 0; u < side * side; ++u)
+    {
+        std::vector<std::pair<int, int>> a, b;
+        packedGrid.for_each_arc(u, [&](auto v, int w) { a.push_back({static_cast<int>(v), w}); });
+        streamedGrid.for_each_arc(u, [&](auto v, int w) { b.push_back({static_cast<int>(v), w}); });
+        sameArcs = sameArcs && a == b;
+    }
+    std::cout << "Streamed grid: same lists " << sameArcs << ", same fingerprint "
+              << (streamedGrid.fingerprint() == grid.fingerprint()) << ", " << streamedGrid.memory_bytes() << " bytes" << std::endl;
+
+    // ===== Parallel builder =====
+    // Same lists as addEdges (input order kept), built by 4 threads
+    std::vector<GraphEdge> many;
+    for (int i = 0; i < 100000; ++i) many.push_back({i * 7 % 1000, (i * 31 + 13) % 997, 1 + i % 5});
+    Graph sequential(1000, false);
+    sequential.addEdges(many);
+    GraphBuildOptions four;
+    four.threads = 4;
+    Graph parallel = build_graph_parallel(1000, false, many, four);
+    std::cout << "Parallel build threads: " << ParallelGraphBuilder<int, int>(four).threads_for(1000, 2 * many.size())
+              << ", same lists as addEdges: " << (parallel.getAdjList() == sequential.getAdjList() && parallel.getWeightList() == sequential.getWeightList())
+              << ", edges: " << parallel.get_edges() << std::endl;
+
+    // Sorted + deduplicated: the last weight of a repeated edge wins, the self-loop keeps both halves
+    GraphBuildOptions dedup;
+    dedup.duplicates = DuplicateEdgePolicy::KeepLast;
+    Graph unique = build_graph_parallel(3, false, std::vector<GraphEdge>{{2, 0, 1}, {0, 1, 4}, {1, 0, 9}, {1, 1, 3}, {1, 1, 6}}, dedup);
+    std::cout << "Deduplicated adjacency list (edges: " << unique.get_edges() << "):\n";
+    unique.print();
+    std::cout << "capacity(0,1): " << unique.get_capacity(0, 1) << ", capacity(1,1): " << unique.get_capacity(1, 1) << std::endl;
+
+    // Invalid edge (should throw out_of_range, like addEdges)
+    try {
+        build_graph_parallel(2, true, std::vector<GraphEdge>{{0, 1}, {0, 2}});
+    } catch (const std::out_of_range& e) {
+        std::cout << "Caught exception: " << e.what() << std::endl;
+    }
+
+    // ===== Duplicate edge policy =====
+    // 0-1 three times, 2-3 twice (once reversed): every merging policy leaves 3 edges
+    const std::vector<GraphEdge> repeated = {{0, 1, 4}, {1, 2, 1}, {0, 1, 2}, {2, 3, 5}, {1, 0, 7}, {3, 2, 1}};
+    for (auto [name, policy] : {std::pair<const char*, DuplicateEdgePolicy>{"MAX", DuplicateEdgePolicy::KeepMax},
+                                {"SUM", DuplicateEdgePolicy::SumCapacities}, {"LAST", DuplicateEdgePolicy::KeepLast}})
+    {
+        Graph merged(4, false);
+        merged.addEdges(repeated);
+        std::size_t removed = merged.collapse_duplicate_edges(policy);
+        std::cout << name << ": removed " << removed << ", edges " << merged.get_edges()
+                  << ", capacity(0,1): " << merged.get_capacity(0, 1) << ", capacity(2,3): " << merged.get_capacity(2, 3) << std::endl;
+    }
+    // Reject (should throw invalid_argument and leave the graph as it was)
+    Graph strict(4, false);
+    strict.addEdges(repeated);
+    try {
+        strict.collapse_duplicate_edges(parse_duplicate_policy("REJECT"));
+    } catch (const std::invalid_argument& e) {
+        std::cout << "Caught exception: " << e.what() << ", edges still " << strict.get_edges() << std::endl;
+    }
+
+    // ===== Mutations and versions =====
+    Graph live(4, false);
+    live.addEdges(std::vector<GraphEdge>{{0, 1, 2}, {1, 2, 3}, {2, 3, 4}});
+    GraphFingerprint original = live.fingerprint();
+    live.enable_change_log();
+    std::uint64_t seen = live.version();
+    long long totalCapacity = 9; // a result kept up to date from the change log instead of recomputed
+    live.setWeight(2, 1, 10);
+    live.removeEdge(0, 1);
+    live.addEdge(3, 0, 5);
+    std::vector<Graph::Change> changes;
+    if (live.changes_since(seen, changes))
+    {
+        for (const auto& c : changes)
+        {
+            if (c.kind == Graph::Change::Kind::Add) totalCapacity += c.weight;
+            else if (c.kind == Graph::Change::Kind::Remove) totalCapacity -= c.weight;
+            else totalCapacity += c.weight - c.previous;
+        }
+    }
+    std::cout << "Version " << seen << " -> " << live.version() << ", " << changes.size() << " changes, total capacity: " << totalCapacity << "\n";
+    live.print();
+    std::cout << "capacity(1,2): " << live.get_capacity(1, 2) << ", remove missing edge: " << live.removeEdge(0, 2) << std::endl;
+    // Undo everything: the fingerprint is back to the original one
+    live.removeEdge(3, 0);
+    live.addEdge(0, 1, 2);
+    live.setWeight(1, 2, 3);
+    std::cout << "Undone, same fingerprint: " << (live.fingerprint() == original) << std::endl;
+
+    // ===== Memory accounting =====
+    // The builder fills every list to its exact size, so the estimate made before building is exact
+    GraphMemoryUsage used = parallel.memory_usage();
+    GraphMemoryUsage estimated = Graph::estimate_memory(1000, many.size(), false);
+    std::cout << "Memory: adjacency " << used.adjacency << ", weights " << used.weights << ", overhead " << used.overhead
+              << ", total " << used.total() << ", estimate matches: " << (estimated.total() == used.total()) << std::endl;
+
+    // ===== Arena allocation =====
+    // Every list of the graph comes from one monotonic buffer, freed at once when the arena goes away;
+    // a copy goes back to the default heap (it may outlive the arena)
+    std::pmr::monotonic_buffer_resource arena(1 << 20);
+    Graph inArena(1000, false, &arena);
+    inArena.addEdges(many);
+    Graph copied = inArena;
+    std::cout << "Arena graph, same lists: " << (inArena.getAdjList() == sequential.getAdjList())
+              << ", uses the arena: " << (inArena.get_memory_resource() == &arena)
+              << ", copy on the default heap: " << (copied.get_memory_resource() == std::pmr::get_default_resource()) << std::endl;
+
+    // ===== Fingerprint =====
+    // Same edges in another order (and the reverse orientation): same fingerprint; one more edge: a new one
+    Graph shuffled(1000, false);
+    std::vector<GraphEdge> reversed;
+    for (auto it = many.rbegin(); it != many.rend(); ++it) reversed.push_back({it->v, it->u, it->w});
+    shuffled.addEdges(reversed);
+    std::cout << "Fingerprint: " << sequential.fingerprint().to_string() << std::endl;
+    std::cout << "Reordered edges, same fingerprint: " << (shuffled.fingerprint() == sequential.fingerprint())
+              << ", parallel build: " << (parallel.fingerprint() == sequential.fingerprint())
+              << ", compressed: " << (CompressedGraph(sequential).fingerprint() == sequential.fingerprint()) << std::endl;
+    shuffled.addEdge(0, 1, 1);
+    std::cout << "After addEdge(0, 1, 1), same fingerprint: " << (shuffled.fingerprint() == sequential.fingerprint()) << std::endl;
+
     return 0;
 }
@@ -0,0 +1,120 @@
+/*
+@ author: Roy Meoded
+@ author: Yarin Keshet
+
+@ description: Byte budget shared by the concurrent requests of a server (part_8, part_9).
+                A request reserves the estimated size of its graph before allocating it, adjusts the reservation
+                to the real size once the graph exists, and gives it back when the graph is freed.
+                The reservation is one compare-exchange loop on the shared counter, so concurrent requests cannot
+                all pass a check against the same "used" value and then allocate together.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+class MemoryBudget
+{
+public:
+    explicit MemoryBudget(std::size_t limit) : limit(limit) {}
+
+    // Set once at startup, before any request is served
+    void set_limit(std::size_t bytes) { limit = bytes; }
+    std::size_t get_limit() const { return limit; }
+    std::size_t get_used() const { return used.load(); }
+
+    // Reserve bytes next to what is reserved already, or throw std::length_error (nothing reserved then)
+    void acquire(std::size_t bytes)
+    {
+        std::size_t current = used.load();
+        do
+        {
+            if (bytes > limit || current > limit - bytes)
+            {
+                throw std::length_error("memory budget exceeded: graph needs " + std::to_string(bytes) + " bytes, " +
+                                        std::to_string(current) + " in use, budget " + std::to_string(limit));
+            }
+        } while (!used.compare_exchange_weak(current, current + bytes));
+    }
+
+    void release(std::size_t bytes) { used.fetch_sub(bytes); }
+
+    // Turn a reservation of `from` bytes into one of `to` bytes (the real size of a graph that already exists,
+    // so this never fails)
+    void adjust(std::size_t from, std::size_t to)
+    {
+        if (to > from)
+        {
+            used.fetch_add(to - from);
+        }
+        else
+        {
+            used.fetch_sub(from - to);
+        }
+    }
+
+private:
+    std::size_t limit;
+    std::atomic<std::size_t> used{0};
+};
+
+// Bytes reserved in a MemoryBudget, given back on destruction (every early return of a request releases them)
+class MemoryReservation
+{
+public:
+    MemoryReservation() = default;
+    MemoryReservation(MemoryBudget& budget, std::size_t bytes) : budget(&budget), bytes(bytes) { budget.acquire(bytes); }
+    ~MemoryReservation() { reset(); }
+
+    MemoryReservation(const MemoryReservation&) = delete;
+    MemoryReservation& operator=(const MemoryReservation&) = delete;
+    MemoryReservation(MemoryReservation&& other) noexcept
+        : budget(std::exchange(other.budget, nullptr)), bytes(std::exchange(other.bytes, 0)) {}
+    MemoryReservation& operator=(MemoryReservation&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            budget = std::exchange(other.budget, nullptr);
+            bytes = std::exchange(other.bytes, 0);
+        }
+        return *this;
+    }
+
+    std::size_t size() const { return bytes; }
+
+    // Now hold the real size instead of the estimate
+    void resize(std::size_t actual)
+    {
+        if (budget)
+        {
+            budget->adjust(bytes, actual);
+        }
+        bytes = actual;
+    }
+
+    // Stop owning the bytes (the caller releases them later, e.g. when a pipeline job leaves); returns them
+    std::size_t detach()
+    {
+        budget = nullptr;
+        return std::exchange(bytes, 0);
+    }
+
+    void reset()
+    {
+        if (budget)
+        {
+            budget->release(bytes);
+        }
+        budget = nullptr;
+        bytes = 0;
+    }
+
+private:
+    MemoryBudget* budget = nullptr;
+    std::size_t bytes = 0;
+};
@@ -0,0 +1,78 @@
+/*
+@ author: Roy Meoded
+@ author: Yarin Keshet
+
+@ description: Philox4x32-10, a counter-based random number generator (Salmon et al., "Parallel Random Numbers:
+                As Easy as 1, 2, 3", SC 2011), implemented here to avoid a dependency.
+Output block n of a stream is a pure function of (key, counter n): any part of any stream is computed without
+the parts before it, so threads can draw disjoint pieces of a random sequence and still produce exactly what
+a single thread would (the parallel generator of edge_sampling.hpp).
+*/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace philox
+{
+    using Counter = std::array<std::uint32_t, 4>;
+    using Key = std::array<std::uint32_t, 2>;
+
+    // One 128-bit output block: ten rounds of multiply / xor over the counter, the key bumped every round
+    inline Counter block(Counter ctr, Key key)
+    {
+        constexpr std::uint64_t M0 = 0xD2511F53, M1 = 0xCD9E8D57;
+        constexpr std::uint32_t W0 = 0x9E3779B9, W1 = 0xBB67AE85;
+        for (int round = 0; round < 10; ++round)
+        {
+            std::uint64_t p0 = M0 * ctr[0], p1 = M1 * ctr[2];
+            ctr = {static_cast<std::uint32_t>(p1 >> 32) ^ ctr[1] ^ key[0], static_cast<std::uint32_t>(p1),
+                   static_cast<std::uint32_t>(p0 >> 32) ^ ctr[3] ^ key[1], static_cast<std::uint32_t>(p0)};
+            key[0] += W0;
+            key[1] += W1;
+        }
+        return ctr;
+    }
+}
+
+/*
+One Philox stream as a UniformRandomBitGenerator of 64-bit values: the key is the seed, the upper half of the
+counter the stream id and the lower half the block position (two outputs per block).
+PhiloxStream(seed, stream, position) starts at block `position` of the stream.
+*/
+class PhiloxStream
+{
+public:
+    using result_type = std::uint64_t;
+
+    PhiloxStream(std::uint64_t seed, std::uint64_t stream, std::uint64_t position = 0)
+        : key{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)},
+          stream(stream), position(position) {}
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return ~result_type(0); }
+
+    result_type operator()()
+    {
+        if (has_spare)
+        {
+            has_spare = false;
+            return spare;
+        }
+        philox::Counter out = philox::block({static_cast<std::uint32_t>(position), static_cast<std::uint32_t>(position >> 32),
+                                             static_cast<std::uint32_t>(stream), static_cast<std::uint32_t>(stream >> 32)},
+                                            key);
+        ++position;
+        spare = (static_cast<std::uint64_t>(out[3]) << 32) | out[2];
+        has_spare = true;
+        return (static_cast<std::uint64_t>(out[1]) << 32) | out[0];
+    }
+
+private:
+    philox::Key key;
+    std::uint64_t stream;
+    std::uint64_t position;
+    std::uint64_t spare = 0;
+    bool has_spare = false;
+};
@@ -0,0 +1,53 @@
+/*
+@ author: Roy Meoded
+@ author: Yarin Keshet
+
+@ description: Reference-counted, immutable graph snapshots with copy-on-write.
+                - GraphSnapshot (std::shared_ptr<const Graph>) is what readers hold: algorithms and pipeline jobs
+                  share one Graph without copying it, and it can never change under them.
+                - SharedGraph is the owner side: read() returns the current graph, snapshot() hands out another
+                  reference, and write() gives mutable access, cloning the graph first only if a snapshot
+                  of the current version is still alive somewhere (copy-on-write).
+                The owner of a SharedGraph must be a single thread; snapshots may be used from any thread.
+*/
+
+#pragma once
+
+#include <memory>
+#include <utility>
+
+#include "graph_impl.hpp"
+
+// Immutable shared graph, safe to pass between threads/stages by value
+using GraphSnapshot = std::shared_ptr<const Graph>;
+
+// Wrap a freshly built graph into a snapshot (moves, does not copy the edges)
+inline GraphSnapshot make_snapshot(Graph&& g)
+{
+    return std::make_shared<const Graph>(std::move(g));
+}
+
+class SharedGraph
+{
+public:
+    explicit SharedGraph(Graph&& g) : current(std::make_shared<Graph>(std::move(g))) {}
+
+    // Current version (read only)
+    const Graph& read() const { return *current; }
+
+    // Another reference to the current version; it stays unchanged even if write() is called later
+    GraphSnapshot snapshot() const { return current; }
+
+    // Mutable access: clones the graph only if some snapshot of the current version is still alive
+    Graph& write()
+    {
+        if (current.use_count() != 1)
+        {
+            current = std::make_shared<Graph>(*current);
+        }
+        return *current;
+    }
+
+private:
+    std::shared_ptr<Graph> current;
+};
@@ -0,0 +1,65 @@
+/*
+@ author: Roy Meoded
+@ author: Yarin Keshet
+
+@ description: Small helpers for the fork-join loops of the parallel graph code (graph_builder.cpp,
+                part_2/euler_parallel.cpp): run one function per thread, split a range into contiguous parts.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/*
+Run f(t) for every t in [0, threads): t = 0 on the calling thread, the others on their own std::thread.
+An exception thrown by f(t) is kept until every thread has joined; then the one of the lowest t is rethrown
+(chunks are in input order, so this is the error a sequential pass would have hit first).
+*/
+template <typename F>
+void run_on_threads(unsigned threads, F f)
+{
+    std::vector<std::exception_ptr> errors(threads);
+    auto guarded = [&](unsigned t)
+    {
+        try
+        {
+            f(t);
+        }
+        catch (...)
+        {
+            errors[t] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (unsigned t = 1; t < threads; ++t)
+    {
+        workers.emplace_back(guarded, t);
+    }
+    guarded(0);
+    for (auto& w : workers)
+    {
+        w.join();
+    }
+    for (auto& e : errors)
+    {
+        if (e)
+        {
+            std::rethrow_exception(e);
+        }
+    }
+}
+
+// [first, last) of part t when n items are split into `parts` contiguous parts of (almost) equal size
+inline std::pair<std::size_t, std::size_t> part_range(std::size_t n, unsigned parts, unsigned t)
+{
+    std::size_t base = n / parts, rest = n % parts;
+    std::size_t first = base * t + std::min<std::size_t>(t, rest);
+    return {first, first + base + (t < rest ? 1 : 0)};
+}
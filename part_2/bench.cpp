@@ -0,0 +1,114 @@
+/*
+@author: Roy Meoded
+@author: Yarin Keshet
+
+@ description: Benchmark of the sequential (EulerCircle) and the parallel (ParallelEulerCircle) Eulerian circuit
+on a large random Eulerian graph (generate_eulerian_graph, part_3). Both circuits are checked against the
+edge list of the graph.
+
+Usage: ./euler_bench -v <vertices> -e <edges> [-s <seed>] [-t <threads>] [-d]
+       -d: directed graph; -t 0 (default): one thread per core
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <unistd.h> // getopt
+#include <utility>
+#include <vector>
+
+#include "euler_circle.hpp"
+#include "euler_parallel.hpp"
+#include "../part_3/random_graph.hpp"
+
+// Every edge of g exactly once, first == last (sorted edge lists compared, O(E log E))
+static bool is_circuit(const Graph& g, const std::vector<int>& circuit)
+{
+    if (circuit.size() != g.get_edges() + 1 || circuit.front() != circuit.back())
+    {
+        return false;
+    }
+    auto key = [&](int u, int v)
+    {
+        return g.is_directed() ? std::make_pair(u, v) : std::make_pair(std::min(u, v), std::max(u, v));
+    };
+    std::vector<std::pair<int, int>> walked, edges;
+    walked.reserve(g.get_edges());
+    edges.reserve(g.get_edges());
+    for (std::size_t i = 0; i + 1 < circuit.size(); ++i)
+    {
+        walked.push_back(key(circuit[i], circuit[i + 1]));
+    }
+    for (int u = 0; u < g.get_vertices(); ++u)
+    {
+        const auto& neighbors = g.get_neighbors(u);
+        for (std::size_t i = 0; i < neighbors.size(); ++i)
+        {
+            int v = neighbors[i];
+            // undirected: every edge is listed from both ends, a self-loop twice in its own list
+            if (g.is_directed() || u < v || (u == v && i % 2 == 0))
+            {
+                edges.push_back(key(u, v));
+            }
+        }
+    }
+    std::sort(walked.begin(), walked.end());
+    std::sort(edges.begin(), edges.end());
+    return walked == edges;
+}
+
+template <typename F>
+static double seconds(F f)
+{
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[])
+{
+    int vertices = 0, edges = 0, seed = 1;
+    unsigned threads = 0;
+    bool directed = false;
+    int opt;
+    while ((opt = getopt(argc, argv, "v:e:s:t:d")) != -1)
+    {
+        switch (opt)
+        {
+            case 'v': vertices = std::atoi(optarg); break;
+            case 'e': edges = std::atoi(optarg); break;
+            case 's': seed = std::atoi(optarg); break;
+            case 't': threads = static_cast<unsigned>(std::atoi(optarg)); break;
+            case 'd': directed = true; break;
+            default:
+                std::cerr << "Usage: " << argv[0] << " -v <vertices> -e <edges> [-s <seed>] [-t <threads>] [-d]\n";
+                return 1;
+        }
+    }
+
+    try
+    {
+        auto start = std::chrono::steady_clock::now();
+        Graph g = generate_eulerian_graph(vertices, edges, seed, directed, threads);
+        double gen = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "Graph: " << vertices << " vertices, " << edges << (directed ? " arcs" : " edges")
+                  << " (generated in " << gen << " s)\n";
+
+        std::vector<int> sequential, parallel;
+        double seq = seconds([&] { sequential = EulerCircle(g).eulerianCircuit(); });
+        ParallelEulerCircle pec(g, threads);
+        double par = seconds([&] { parallel = pec.eulerianCircuit(); });
+
+        std::cout << "Sequential: " << seq << " s, " << (is_circuit(g, sequential) ? "valid" : "INVALID") << "\n";
+        std::cout << "Parallel (" << pec.threads_for(directed ? g.get_edges() : 2 * g.get_edges()) << " threads): "
+                  << par << " s, " << (is_circuit(g, parallel) ? "valid" : "INVALID") << "\n";
+        std::cout << "Speedup: " << seq / par << "\n";
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
@@ -1,76 +1,473 @@
 #include "euler_circle.hpp"
 
-void EulerCircle::findEulerianCircuit() 
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+// Prints a circuit or path as "label: v0 v1 ... "
+static void printWalk(std::ostream& os, const char* label, const std::vector<int>& walk)
+{
+    os << label << ": ";
+    for (int v : walk)
+    {
+        os << v << " ";
+    }
+    os << std::endl;
+}
+
+void EulerCircle::findEulerianCircuit(std::ostream& os)
 {
-    std::vector<std::vector<int>> adjList = g.getAdjList();
-    int V = adjList.size();
+    int V = g.get_vertices();
     bool isEulerian = true;
-    // Check for undirected graph: all degrees must be even
-    for (int u = 0; u < V; ++u) 
+    if (!g.is_directed())
     {
-        if (adjList[u].size() % 2 != 0) 
+        // Check for undirected graph: all degrees must be even
+        for (int u = 0; u < V; ++u)
         {
-            isEulerian = false;
-            std::cout << "Vertex " << u << " has odd degree: " << adjList[u].size() << std::endl;
+            std::size_t degree = g.get_neighbors(u).size();
+            if (degree % 2 != 0)
+            {
+                isEulerian = false;
+                os << "Vertex " << u << " has odd degree: " << degree << std::endl;
+            }
         }
     }
-    if (!isEulerian) 
+    else
     {
-        std::cout << "No Eulerian circuit exists: not all vertices have even degree." << std::endl;
+        // Check for directed graph: every in-degree must equal the out-degree
+        std::vector<std::size_t> in = inDegrees();
+        for (int u = 0; u < V; ++u)
+        {
+            std::size_t out = g.get_neighbors(u).size();
+            if (in[u] != out)
+            {
+                isEulerian = false;
+                os << "Vertex " << u << " has in-degree " << in[u] << " and out-degree " << out << std::endl;
+            }
+        }
+    }
+    if (!isEulerian)
+    {
+        os << (g.is_directed() ? "No Eulerian circuit exists: in-degree and out-degree differ."
+                               : "No Eulerian circuit exists: not all vertices have even degree.")
+           << std::endl;
+        std::vector<int> path = eulerianPath();
+        if (!path.empty())
+        {
+            printWalk(os, "Eulerian path", path);
+        }
         return;
     }
 
-    // If all degrees are even, run Hierholzer's algorithm
-    std::vector<int> circuit; // initialize
-    hierholzer(adjList, 0, circuit);
+    std::vector<int> circuit = eulerianCircuit();
+    if (circuit.empty())
+    {
+        os << "No Eulerian circuit exists: the edges are not connected." << std::endl;
+        return;
+    }
     // Print the Eulerian circuit
-    std::cout << "Eulerian circuit: ";
-    for (int v : circuit) 
+    printWalk(os, "Eulerian circuit", circuit);
+}
+
+std::vector<int> EulerCircle::eulerianCircuit() const
+{
+    int start = startVertex(true);
+    return start < 0 ? std::vector<int>() : walkFrom(start);
+}
+
+std::vector<int> EulerCircle::eulerianPath() const
+{
+    int start = startVertex(false);
+    return start < 0 ? std::vector<int>() : walkFrom(start);
+}
+
+std::vector<std::size_t> EulerCircle::inDegrees() const
+{
+    std::vector<std::size_t> in(g.get_vertices(), 0);
+    for (int u = 0; u < g.get_vertices(); ++u)
+    {
+        for (int v : g.get_neighbors(u))
+        {
+            ++in[v];
+        }
+    }
+    return in;
+}
+
+/*
+Undirected: no odd vertex -> circuit from the first vertex with an edge; exactly two -> path from the first one.
+Directed: all balanced -> circuit from the first vertex with an edge; exactly one vertex with out = in + 1 and
+one with in = out + 1 (all others balanced) -> path from the first of them.
+Isolated vertices are ignored; a graph without edges starts (and ends) at 0.
+*/
+int EulerCircle::startVertex(bool closed) const
+{
+    const int V = g.get_vertices();
+    int first = -1;
+    if (!g.is_directed())
+    {
+        int odd = 0, firstOdd = -1;
+        for (int u = 0; u < V; ++u)
+        {
+            std::size_t degree = g.get_neighbors(u).size();
+            if (degree > 0 && first < 0)
+            {
+                first = u;
+            }
+            if (degree % 2 != 0 && odd++ == 0)
+            {
+                firstOdd = u;
+            }
+        }
+        if (odd == 0)
+        {
+            return first < 0 ? 0 : first;
+        }
+        return (!closed && odd == 2) ? firstOdd : -1;
+    }
+
+    std::vector<std::size_t> in = inDegrees();
+    int from = -1, to = -1;
+    for (int u = 0; u < V; ++u)
+    {
+        std::size_t out = g.get_neighbors(u).size();
+        if (out > 0 && first < 0)
+        {
+            first = u;
+        }
+        if (out == in[u])
+        {
+            continue;
+        }
+        if (out == in[u] + 1 && from < 0)
+        {
+            from = u;
+        }
+        else if (in[u] == out + 1 && to < 0)
+        {
+            to = u;
+        }
+        else
+        {
+            return -1;
+        }
+    }
+    if (from < 0 && to < 0)
+    {
+        return first < 0 ? 0 : first;
+    }
+    return (!closed && from >= 0 && to >= 0) ? from : -1;
+}
+
+std::vector<int> EulerCircle::walkFrom(int start) const
+{
+    std::vector<std::size_t> offset, edgeOf;
+    std::size_t edges = edgeIds(offset, edgeOf);
+    if (edges == 0)
+    {
+        return {start};
+    }
+    std::vector<int> walk = hierholzer(start, offset, edgeOf, edges);
+    if (walk.size() != edges + 1)
+    {
+        return {}; // some edges are not reachable from start
+    }
+    return walk;
+}
+
+/*
+Directed: arc a is edge a, nothing to store. Undirected, one pass over the vertices in increasing order:
+- an arc u -> v with u < v opens a new edge id, remembered in the bucket of v as (u, id);
+- a self-loop opens an id on its first entry and closes it on the second;
+- an arc u -> v with v < u takes an id from the bucket of u. Parallel edges are matched through a chain
+  per neighbor (head[v] -> next entry of the same v), so a lookup is O(1) instead of a scan of the bucket.
+Every arc and every bucket entry is touched a constant number of times: O(V+E).
+*/
+template <typename Index>
+std::size_t EulerCircle::edgeIds(std::vector<Index>& offset, std::vector<Index>& edgeOf) const
+{
+    const Index none = std::numeric_limits<Index>::max();
+    const int V = g.get_vertices();
+
+    offset.assign(V + 1, 0);
+    if (g.is_directed())
+    {
+        for (int u = 0; u < V; ++u)
+        {
+            offset[u + 1] = offset[u] + static_cast<Index>(g.get_neighbors(u).size());
+        }
+        edgeOf.clear();
+        return offset[V];
+    }
+    std::vector<Index> bucketStart(V + 1, 0);
+    for (int u = 0; u < V; ++u)
+    {
+        const auto& neighbors = g.get_neighbors(u);
+        offset[u + 1] = offset[u] + static_cast<Index>(neighbors.size());
+        for (int v : neighbors)
+        {
+            if (u < v)
+            {
+                ++bucketStart[v + 1];
+            }
+        }
+    }
+    for (int v = 0; v < V; ++v)
+    {
+        bucketStart[v + 1] += bucketStart[v];
+    }
+
+    edgeOf.assign(offset[V], none);
+    std::vector<std::pair<int, Index>> bucket(bucketStart[V]); // (smaller endpoint, edge id)
+    std::vector<Index> fill(bucketStart.begin(), bucketStart.end() - 1);
+    std::vector<Index> chain(bucket.size());
+    std::vector<Index> head(V, none);
+    Index edges = 0;
+
+    for (int u = 0; u < V; ++u)
     {
-        std::cout << v << " ";
+        for (Index p = bucketStart[u]; p < bucketStart[u + 1]; ++p)
+        {
+            int w = bucket[p].first;
+            chain[p] = head[w];
+            head[w] = p;
+        }
+
+        const auto& neighbors = g.get_neighbors(u);
+        Index openLoop = none;
+        for (std::size_t i = 0; i < neighbors.size(); ++i)
+        {
+            int v = neighbors[i];
+            Index a = offset[u] + static_cast<Index>(i);
+            if (u < v)
+            {
+                edgeOf[a] = edges;
+                bucket[fill[v]++] = {u, edges};
+                ++edges;
+            }
+            else if (u == v)
+            {
+                if (openLoop == none)
+                {
+                    openLoop = edges++;
+                    edgeOf[a] = openLoop;
+                }
+                else
+                {
+                    edgeOf[a] = openLoop;
+                    openLoop = none;
+                }
+            }
+            else
+            {
+                Index p = head[v];
+                if (p == none)
+                {
+                    throw std::invalid_argument("adjacency lists are not symmetric");
+                }
+                edgeOf[a] = bucket[p].second;
+                head[v] = chain[p];
+            }
+        }
+
+        if (openLoop != none)
+        {
+            throw std::invalid_argument("adjacency lists are not symmetric");
+        }
+        for (Index p = bucketStart[u]; p < bucketStart[u + 1]; ++p)
+        {
+            if (head[bucket[p].first] != none)
+            {
+                throw std::invalid_argument("adjacency lists are not symmetric");
+            }
+        }
     }
-    std::cout << std::endl;
+    return edges;
 }
 
 /*
 Hierholzer’s algorithm finds an Eulerian circuit by:
 
 1. Starting at any vertex.
-2. Following edges (removing them as you go) until you return to the starting vertex, forming a cycle.
+2. Following edges (marking them as used) until you get stuck: back at the start for a circuit, at the
+other end for a path.
 3. If there are unused edges, start a new cycle from a vertex in the existing cycle that has unused edges,
 and merge the cycles.
 4. Repeat until all edges are used.
 
-Result: a path that visits every edge exactly once and returns to the start.
+Result: a walk that visits every edge exactly once (and returns to the start for a circuit).
+Directed graphs only follow out-arcs, which is all the difference: the ids are the arcs themselves.
 
+The cursor of a vertex only moves forward: an arc whose edge was used from the other side is skipped once
+and never looked at again, so the whole walk is O(V+E). Directed graphs need no used-set at all (edgeOf
+empty): an arc can only be taken through the cursor of its own tail.
+target(u, a) is the head of arc a of u; emit(u) gets the vertices as they leave the stack (the walk reversed).
+Index is the integer type of the arc and edge ids (32-bit ids halve the bookkeeping when the arcs fit).
 */
-void EulerCircle::hierholzer(std::vector<std::vector<int>>& adjList, int start, std::vector<int>& circuit) 
+template <typename Index, typename Target, typename Emit>
+static void hierholzerWalk(int start, const std::vector<Index>& offset, const std::vector<Index>& edgeOf,
+                           std::size_t edges, Target target, Emit emit)
 {
-    std::vector<int> stack;
+    std::vector<bool> used(edgeOf.empty() ? 0 : edges, false);
+    std::vector<Index> cursor(offset.begin(), offset.end() - 1); // next arc to try, per vertex
+    std::vector<int> stack; // the open trail: up to E + 1 vertices when the walk goes around in one piece
     stack.push_back(start);
-    while (!stack.empty()) 
+    while (!stack.empty())
     {
         int u = stack.back();
-        if (!adjList[u].empty()) 
+        Index& next = cursor[u];
+        while (next < offset[u + 1] && !edgeOf.empty() && used[edgeOf[next]])
         {
-            int v = adjList[u].back(); // saves the v vertex
-            adjList[u].pop_back(); // removes the last neighbor (vertex) from the adjacency list of vertex u(the edge uv is removed)
-            // Remove the edge in the other direction for undirected graphs
-            for (auto it = adjList[v].begin(); it != adjList[v].end(); ++it) 
+            ++next;
+        }
+        if (next < offset[u + 1])
+        {
+            if (!edgeOf.empty())
             {
-                if (*it == u) 
-                {
-                    adjList[v].erase(it);
-                    break;
-                }
+                used[edgeOf[next]] = true;
             }
-            stack.push_back(v);
+            stack.push_back(target(u, next));
+            ++next;
         }
-        else 
+        else
         {
-            circuit.push_back(u);
+            emit(u);
             stack.pop_back();
         }
     }
+}
+
+std::vector<int> EulerCircle::hierholzer(int start, const std::vector<std::size_t>& offset,
+                                         const std::vector<std::size_t>& edgeOf, std::size_t edges) const
+{
+    std::vector<int> circuit;
+    circuit.reserve(edges + 1);
+    hierholzerWalk(start, offset, edgeOf, edges,
+                   [&](int u, std::size_t a) { return g.get_neighbors(u)[a - offset[u]]; },
+                   [&](int u) { circuit.push_back(u); });
     std::reverse(circuit.begin(), circuit.end()); // reverse the circuit to get the correct order
+    return circuit;
+}
+
+bool EulerCircle::edgesConnected() const
+{
+    const int V = g.get_vertices();
+    std::vector<int> parent(V);
+    std::iota(parent.begin(), parent.end(), 0);
+    auto find = [&](int x)
+    {
+        while (parent[x] != x)
+        {
+            parent[x] = parent[parent[x]]; // path halving
+            x = parent[x];
+        }
+        return x;
+    };
+    for (int u = 0; u < V; ++u)
+    {
+        for (int v : g.get_neighbors(u))
+        {
+            parent[find(u)] = find(v);
+        }
+    }
+    int root = -1;
+    for (int u = 0; u < V; ++u)
+    {
+        if (g.get_neighbors(u).empty())
+        {
+            continue; // isolated, or (directed) only reached by arcs: joined through their tails
+        }
+        if (root < 0)
+        {
+            root = find(u);
+        }
+        else if (find(u) != root)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+Connectivity is checked before the walk, so nothing is emitted for a graph without a circuit.
+The stack pops the circuit back to front:
+- undirected: the reversed circuit is an Eulerian circuit too (same start, same edges), emitted as is;
+- directed: the walk follows the reversed arcs (a CSR of in-arcs), whose circuit popped back to front is a
+  circuit of g front to back.
+Memory is still O(V + E), not bounded by chunk: the walk keeps an id per arc, a used bit per edge, a cursor per
+vertex and its stack (up to E + 1 vertices). What streaming saves is the circuit vector (4 bytes per edge)
+and the response text; the ids are 32-bit whenever the arc count fits, half of what eulerianCircuit() keeps.
+*/
+bool EulerCircle::streamEulerianCircuit(const CircuitSink& sink, std::size_t chunk) const
+{
+    int start = startVertex(true);
+    if (start < 0 || !edgesConnected())
+    {
+        return false;
+    }
+    chunk = std::max<std::size_t>(chunk, 1);
+    std::vector<int> buffer;
+    buffer.reserve(chunk);
+    auto emit = [&](int u)
+    {
+        buffer.push_back(u);
+        if (buffer.size() == chunk)
+        {
+            sink(buffer.data(), buffer.size());
+            buffer.clear();
+        }
+    };
+
+    const int V = g.get_vertices();
+    auto walk = [&](auto indexType)
+    {
+        using Index = decltype(indexType);
+        if (!g.is_directed())
+        {
+            std::vector<Index> offset, edgeOf;
+            std::size_t edges = edgeIds(offset, edgeOf);
+            hierholzerWalk(start, offset, edgeOf, edges,
+                           [&](int u, Index a) { return g.get_neighbors(u)[a - offset[u]]; }, emit);
+            return;
+        }
+        std::vector<Index> inOffset(V + 1, 0);
+        for (int u = 0; u < V; ++u)
+        {
+            for (int v : g.get_neighbors(u))
+            {
+                ++inOffset[v + 1];
+            }
+        }
+        for (int v = 0; v < V; ++v)
+        {
+            inOffset[v + 1] += inOffset[v];
+        }
+        std::vector<int> source(inOffset[V]);
+        std::vector<Index> fill(inOffset.begin(), inOffset.end() - 1);
+        for (int u = 0; u < V; ++u)
+        {
+            for (int v : g.get_neighbors(u))
+            {
+                source[fill[v]++] = u;
+            }
+        }
+        fill.clear();
+        fill.shrink_to_fit();
+        hierholzerWalk(start, inOffset, std::vector<Index>{}, inOffset[V], [&](int, Index a) { return source[a]; }, emit);
+    };
+    const std::size_t arcs = g.is_directed() ? g.get_edges() : 2 * g.get_edges();
+    if (arcs < std::numeric_limits<std::uint32_t>::max())
+    {
+        walk(std::uint32_t{});
+    }
+    else
+    {
+        walk(std::size_t{});
+    }
+    if (!buffer.empty())
+    {
+        sink(buffer.data(), buffer.size());
+    }
+    return true;
 }
@@ -1,29 +1,91 @@
 /*
 @author: Roy Meoded
-@author: Yarin Keshet  
+@author: Yarin Keshet
 @ date: 10-10-2025
 
-@ description: This file contains the implementation of the EulerCircle class, 
+@ description: This file contains the implementation of the EulerCircle class,
 which provides functionality to find an Eulerian circuit in a given graph using Hierholzer's algorithm.
+Directed and undirected graphs are supported, as well as Eulerian paths (open trails) when no circuit exists.
+The search runs in O(V+E): every undirected edge gets an id shared by its two arcs, used edges are marked
+in a bitset and every vertex keeps a cursor into its own neighbor list, so the graph is never copied or modified.
 */
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <iostream>
 #include <vector>
 #include <numeric>
 #include <algorithm>
 #include "../part_1/graph_impl.hpp"
 
-class EulerCircle 
+class EulerCircle
 {
 public:
     EulerCircle(const Graph& graph) : g(graph) {}
 
-    void findEulerianCircuit(); 
+    /*
+    Eulerian circuit as a vertex sequence, first == last.
+    Undirected: every degree is even. Directed: in-degree == out-degree everywhere.
+    Empty if there is none (degrees, or edges in more than one connected component).
+    A graph without edges has the trivial circuit {0}.
+    */
+    std::vector<int> eulerianCircuit() const;
+
+    /*
+    Eulerian path: the circuit if there is one, otherwise a path between the two odd-degree vertices
+    (undirected) or from the vertex with out = in + 1 to the one with in = out + 1 (directed).
+    Empty if there is none.
+    */
+    std::vector<int> eulerianPath() const;
+
+    // Receives consecutive pieces of a circuit, in order
+    using CircuitSink = std::function<void(const int* vertices, std::size_t count)>;
+
+    /*
+    Streams the Eulerian circuit to sink in pieces of at most chunk vertices while Hierholzer produces it,
+    without building the vertex sequence. The walk itself still needs O(V + E) memory (arc ids, used edges,
+    its stack), 32-bit where the graph allows; only the circuit and its text are not kept.
+    Returns false, without calling sink, if there is no circuit.
+    */
+    bool streamEulerianCircuit(const CircuitSink& sink, std::size_t chunk = 4096) const;
+
+    /*
+    Prints the circuit, or why there is none (unbalanced vertices / disconnected edges) and the path if any.
+    Writes to os only, so concurrent callers (the part_6 server) can each use their own stream.
+    */
+    void findEulerianCircuit(std::ostream& os = std::cout);
 
     const Graph& g;
 
-    // Hierholzer's algorithm for Eulerian circuit
-    void hierholzer(std::vector<std::vector<int>>& adjList, int start, std::vector<int>& circuit);
-};
\ No newline at end of file
+private:
+    // In-degree of every vertex (directed graphs; undirected degrees are the list sizes)
+    std::vector<std::size_t> inDegrees() const;
+
+    // Where the walk has to start for a circuit (closed = true) or a path, -1 if the degrees rule it out
+    int startVertex(bool closed) const;
+
+    /*
+    Hierholzer from start over all edges. Empty unless every edge was used: with the degree conditions
+    checked by startVertex, that is the connectivity check over the non-isolated vertices.
+    */
+    std::vector<int> walkFrom(int start) const;
+
+    // True if all edges lie in one (weakly) connected component, by union-find over the arcs
+    bool edgesConnected() const;
+
+    /*
+    Edge ids for the arcs of g, in CSR order: the arcs of u are [offset[u], offset[u+1]) and arc
+    offset[u] + i is get_neighbors(u)[i]. Directed: every arc is its own edge and edgeOf stays empty.
+    Undirected: both arcs of an edge get the same id (so do the two entries of a self-loop).
+    Returns the number of edges.
+    */
+    template <typename Index>
+    std::size_t edgeIds(std::vector<Index>& offset, std::vector<Index>& edgeOf) const;
+
+    // Hierholzer's algorithm for Eulerian circuit, from start, over the ids built by edgeIds
+    std::vector<int> hierholzer(int start, const std::vector<std::size_t>& offset,
+                                const std::vector<std::size_t>& edgeOf, std::size_t edges) const;
+};
@@ -0,0 +1,519 @@
+#include "euler_parallel.hpp"
+#include "../part_1/graph_builder.hpp"
+#include "../part_1/thread_utils.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+using Arc = std::uint32_t; // arc index, in CSR order (arc offset[u] + i is get_neighbors(u)[i])
+
+static const Arc NONE = std::numeric_limits<Arc>::max();
+static const Arc SPLIT = 64; // one splitter every SPLIT arcs
+
+/*
+Lock-free union-find over trail ids. A root is only ever linked below a smaller root (so no cycles can form)
+and unite() returns true only for the call that actually joined two sets: the successful calls of all threads
+together form a spanning forest.
+*/
+class ConcurrentUnionFind
+{
+public:
+    explicit ConcurrentUnionFind(std::size_t n) : parent(new std::atomic<Arc>[n]) {}
+
+    void reset(Arc x) { parent[x].store(x, std::memory_order_relaxed); }
+
+    Arc find(Arc x)
+    {
+        while (true)
+        {
+            Arc p = parent[x].load(std::memory_order_acquire);
+            if (p == x)
+            {
+                return x;
+            }
+            Arc gp = parent[p].load(std::memory_order_acquire);
+            if (gp == p)
+            {
+                return p;
+            }
+            parent[x].compare_exchange_weak(p, gp, std::memory_order_acq_rel); // path halving, best effort
+            x = gp;
+        }
+    }
+
+    bool unite(Arc a, Arc b)
+    {
+        while (true)
+        {
+            a = find(a);
+            b = find(b);
+            if (a == b)
+            {
+                return false;
+            }
+            if (a < b)
+            {
+                std::swap(a, b);
+            }
+            Arc expected = a;
+            if (parent[a].compare_exchange_strong(expected, b, std::memory_order_acq_rel))
+            {
+                return true;
+            }
+        }
+    }
+
+private:
+    std::unique_ptr<std::atomic<Arc>[]> parent;
+};
+
+unsigned ParallelEulerCircle::threads_for(std::size_t arcs) const
+{
+    unsigned threads = requested ? requested : std::max(1u, std::thread::hardware_concurrency());
+    const std::size_t minArcsPerThread = std::size_t(1) << 16; // below this a thread costs more than it saves
+    return static_cast<unsigned>(std::min<std::size_t>(threads, std::max<std::size_t>(1, arcs / minArcsPerThread)));
+}
+
+/*
+Every arc ends at an edge end of its head, an index in the arc range of the head; into[s] is the arc arriving at
+end s, and the walk leaves the head along the arc paired with s:
+- undirected: the end of an edge at the head is its other arc (the twin, so into is the twin map);
+  ends 2i and 2i+1 of a list are paired.
+- directed: the k-th in-arc of v arrives at end offset[v] + k and leaves along the k-th out-arc (same index).
+The walk itself only reads next[a] (the arc taken after a), one random access per step. next is read-only
+except for the rotations of phase 3: next[into[s]] for the ends s of v, written by the thread owning v.
+*/
+std::vector<int> ParallelEulerCircle::eulerianCircuit() const
+{
+    const int V = g.get_vertices();
+    const bool directed = g.is_directed();
+    const std::size_t n = static_cast<std::size_t>(V);
+
+    std::vector<Arc> offset(n + 1, 0);
+    for (std::size_t u = 0; u < n; ++u)
+    {
+        std::size_t end = offset[u] + g.get_neighbors(static_cast<int>(u)).size();
+        if (end >= NONE || (directed && end > static_cast<std::size_t>(std::numeric_limits<int>::max())))
+        {
+            throw std::length_error("too many arcs for the parallel Eulerian circuit");
+        }
+        offset[u + 1] = static_cast<Arc>(end);
+        if (!directed && (end - offset[u]) % 2 != 0)
+        {
+            return {}; // odd degree
+        }
+    }
+    const Arc A = offset[n];
+    if (A == 0)
+    {
+        return {0};
+    }
+    int start = 0;
+    while (offset[start + 1] == offset[start])
+    {
+        ++start; // first vertex with an edge, as in EulerCircle
+    }
+    const std::size_t edges = directed ? A : A / 2;
+    const unsigned T = threads_for(A);
+
+    // 1) pairing
+    std::vector<Arc> into(A), next(A);
+    if (!directed)
+    {
+        // the k-th v in the list of u and the k-th u in the list of v are the two arcs of one edge:
+        // sort every list by neighbor, then find the run of u in the list of v by binary search
+        std::vector<std::pair<int, Arc>> sorted(A);
+        run_on_threads(T, [&](unsigned t)
+        {
+            auto [first, last] = part_range(n, T, t);
+            for (std::size_t u = first; u < last; ++u)
+            {
+                const auto& neighbors = g.get_neighbors(static_cast<int>(u));
+                for (std::size_t i = 0; i < neighbors.size(); ++i)
+                {
+                    sorted[offset[u] + i] = {neighbors[i], static_cast<Arc>(offset[u] + i)};
+                }
+                std::sort(sorted.begin() + offset[u], sorted.begin() + offset[u + 1]);
+            }
+        });
+        run_on_threads(T, [&](unsigned t)
+        {
+            auto [first, last] = part_range(n, T, t);
+            for (std::size_t u = first; u < last; ++u)
+            {
+                const Arc b = offset[u], e = offset[u + 1];
+                for (Arc i = b; i < e; )
+                {
+                    const int v = sorted[i].first;
+                    Arc j = i;
+                    while (j < e && sorted[j].first == v)
+                    {
+                        ++j;
+                    }
+                    if (v == static_cast<int>(u))
+                    {
+                        // a self-loop is listed twice in its own list: consecutive entries are its two ends
+                        if ((j - i) % 2 != 0)
+                        {
+                            throw std::invalid_argument("adjacency lists are not symmetric");
+                        }
+                        for (Arc k = i; k < j; k += 2)
+                        {
+                            into[sorted[k].second] = sorted[k + 1].second;
+                            into[sorted[k + 1].second] = sorted[k].second;
+                        }
+                    }
+                    else
+                    {
+                        auto vb = sorted.begin() + offset[v], ve = sorted.begin() + offset[v + 1];
+                        auto r = std::lower_bound(vb, ve, std::make_pair(static_cast<int>(u), Arc(0)));
+                        const Arc count = j - i;
+                        if (static_cast<Arc>(ve - r) < count || (r + (count - 1))->first != static_cast<int>(u) ||
+                            (r + count != ve && (r + count)->first == static_cast<int>(u)))
+                        {
+                            throw std::invalid_argument("adjacency lists are not symmetric");
+                        }
+                        for (Arc k = 0; k < count; ++k)
+                        {
+                            into[sorted[i + k].second] = (r + k)->second;
+                        }
+                    }
+                    i = j;
+                }
+            }
+        });
+        run_on_threads(T, [&](unsigned t)
+        {
+            auto [first, last] = part_range(n, T, t);
+            for (std::size_t u = first; u < last; ++u)
+            {
+                for (Arc x = offset[u]; x < offset[u + 1]; x += 2)
+                {
+                    next[into[x]] = x + 1;
+                    next[into[x + 1]] = x;
+                }
+            }
+        });
+    }
+    else
+    {
+        // in-arcs of every vertex, in arc order: the reversed graph, with the arc index as weight
+        std::vector<GraphEdge> reversed(A);
+        run_on_threads(T, [&](unsigned t)
+        {
+            auto [first, last] = part_range(n, T, t);
+            for (std::size_t u = first; u < last; ++u)
+            {
+                const auto& neighbors = g.get_neighbors(static_cast<int>(u));
+                for (std::size_t i = 0; i < neighbors.size(); ++i)
+                {
+                    reversed[offset[u] + i] = {neighbors[i], static_cast<int>(u), static_cast<int>(offset[u] + i)};
+                }
+            }
+        });
+        GraphBuildOptions options;
+        options.threads = T;
+        Graph in = build_graph_parallel(V, true, reversed, options);
+        reversed.clear();
+        reversed.shrink_to_fit();
+
+        std::vector<char> unbalanced(T, 0);
+        run_on_threads(T, [&](unsigned t)
+        {
+            auto [first, last] = part_range(n, T, t);
+            for (std::size_t v = first; v < last; ++v)
+            {
+                const auto& inArcs = in.get_weights(static_cast<int>(v));
+                if (inArcs.size() != offset[v + 1] - offset[v])
+                {
+                    unbalanced[t] = 1;
+                    continue;
+                }
+                for (std::size_t k = 0; k < inArcs.size(); ++k)
+                {
+                    into[offset[v] + k] = static_cast<Arc>(inArcs[k]);
+                    next[inArcs[k]] = static_cast<Arc>(offset[v] + k);
+                }
+            }
+        });
+        if (std::find(unbalanced.begin(), unbalanced.end(), 1) != unbalanced.end())
+        {
+            return {}; // in-degree != out-degree
+        }
+    }
+
+    /*
+    2) labeling. Splitters: every arc a with a % SPLIT == 0, and (undirected) their twins, so that a trail
+    walked forward and the same trail walked backward have splitters on both or on neither.
+    Rank of a splitter: a / SPLIT, or S0 + twin / SPLIT for a twin. The trail id is an arc of the trail
+    (the smallest splitter or twin of a splitter), the same for both directions of an undirected trail.
+    */
+    std::vector<char> splitter(A); // flags: the test is on the walk, the twin would cost a second random access
+    run_on_threads(T, [&](unsigned t)
+    {
+        auto [first, last] = part_range(A, T, t);
+        for (std::size_t a = first; a < last; ++a)
+        {
+            splitter[a] = a % SPLIT == 0 || (!directed && into[a] % SPLIT == 0);
+        }
+    });
+    auto isSplitter = [&](Arc a) { return splitter[a] != 0; };
+    const Arc S0 = (A + SPLIT - 1) / SPLIT;
+    const Arc ranks = directed ? S0 : 2 * S0;
+    auto rankOf = [&](Arc a) { return a % SPLIT == 0 ? a / SPLIT : S0 + into[a] / SPLIT; };
+
+    std::vector<Arc> splitterArc(ranks + 1, NONE); // + 1: the start arc of phase 4
+    std::vector<Arc> segNext(ranks + 1, NONE), segLen(ranks + 1, 0);
+    std::vector<Arc> label(A, NONE);
+    run_on_threads(T, [&](unsigned t)
+    {
+        auto [first, last] = part_range(S0, T, t);
+        for (std::size_t r = first; r < last; ++r)
+        {
+            const Arc s = static_cast<Arc>(r * SPLIT);
+            splitterArc[r] = s;
+            if (!directed && into[s] % SPLIT != 0)
+            {
+                splitterArc[S0 + r] = into[s];
+            }
+        }
+    });
+    run_on_threads(T, [&](unsigned t)
+    {
+        auto [first, last] = part_range(ranks, T, t);
+        for (std::size_t r = first; r < last; ++r)
+        {
+            Arc a = splitterArc[r], len = 0;
+            if (a == NONE)
+            {
+                continue;
+            }
+            do
+            {
+                label[a] = static_cast<Arc>(r);
+                ++len;
+                a = next[a];
+            } while (!isSplitter(a));
+            segNext[r] = rankOf(a);
+            segLen[r] = len;
+        }
+    });
+
+    std::vector<Arc> trailOf(ranks, NONE); // sequential, over the E / SPLIT splitters only
+    for (Arc r0 = 0; r0 < ranks; ++r0)
+    {
+        if (splitterArc[r0] == NONE || trailOf[r0] != NONE)
+        {
+            continue;
+        }
+        Arc id = NONE, r = r0;
+        do
+        {
+            id = std::min(id, splitterArc[r]);
+            if (!directed)
+            {
+                id = std::min(id, into[splitterArc[r]]);
+            }
+            r = segNext[r];
+        } while (r != r0);
+        do
+        {
+            trailOf[r] = id;
+            r = segNext[r];
+        } while (r != r0);
+    }
+
+    std::vector<char> unsplit(A);
+    run_on_threads(T, [&](unsigned t)
+    {
+        auto [first, last] = part_range(A, T, t);
+        for (std::size_t a = first; a < last; ++a)
+        {
+            unsplit[a] = label[a] == NONE;
+            if (!unsplit[a])
+            {
+                label[a] = trailOf[label[a]];
+            }
+        }
+    });
+    // trails without a splitter (short): labeled by the thread owning their smallest arc
+    run_on_threads(T, [&](unsigned t)
+    {
+        auto [first, last] = part_range(A, T, t);
+        for (Arc a = static_cast<Arc>(first); a < last; ++a)
+        {
+            if (!unsplit[a])
+            {
+                continue;
+            }
+            Arc id = directed ? a : std::min(a, into[a]);
+            bool owner = true;
+            for (Arc b = next[a]; b != a; b = next[b])
+            {
+                if (b < a)
+                {
+                    owner = false;
+                    break;
+                }
+                if (!directed)
+                {
+                    id = std::min(id, into[b]);
+                }
+            }
+            if (!owner)
+            {
+                continue;
+            }
+            Arc b = a;
+            do
+            {
+                label[b] = id;
+                b = next[b];
+            } while (b != a);
+        }
+    });
+    unsplit.clear();
+    unsplit.shrink_to_fit();
+
+    // 3) merging: pairs at v are (s, s) directed (in-slot s leaves along out-arc s), (x, x + 1) undirected
+    ConcurrentUnionFind uf(A);
+    std::vector<std::size_t> trails(T, 0), unions(T, 0);
+    run_on_threads(T, [&](unsigned t)
+    {
+        auto [first, last] = part_range(A, T, t);
+        for (std::size_t a = first; a < last; ++a)
+        {
+            uf.reset(static_cast<Arc>(a));
+            trails[t] += label[a] == a;
+        }
+    });
+    run_on_threads(T, [&](unsigned t)
+    {
+        auto [first, last] = part_range(n, T, t);
+        const Arc step = directed ? 1 : 2;
+        std::vector<Arc> chosen;
+        for (std::size_t v = first; v < last; ++v)
+        {
+            const Arc b = offset[v], e = offset[v + 1];
+            if (b == e)
+            {
+                continue;
+            }
+            chosen.assign(1, b);
+            for (Arc x = b + step; x < e; x += step)
+            {
+                if (uf.unite(label[b], label[x]))
+                {
+                    chosen.push_back(x);
+                }
+            }
+            const std::size_t m = chosen.size();
+            unions[t] += m - 1;
+            if (m < 2)
+            {
+                continue;
+            }
+            if (directed)
+            {
+                // arriving at end chosen[i] now leaves along out-arc chosen[i + 1] (the trail of the next pair)
+                for (std::size_t i = 0; i < m; ++i)
+                {
+                    next[into[chosen[i]]] = chosen[(i + 1) % m];
+                }
+            }
+            else
+            {
+                // pairs (x_i, x_i + 1) become (x_i + 1, x_{i+1})
+                for (std::size_t i = 0; i < m; ++i)
+                {
+                    Arc y = chosen[i] + 1, x = chosen[(i + 1) % m];
+                    next[into[y]] = x;
+                    next[into[x]] = y;
+                }
+            }
+        }
+    });
+    std::size_t trailCount = 0, unionCount = 0;
+    for (unsigned t = 0; t < T; ++t)
+    {
+        trailCount += trails[t];
+        unionCount += unions[t];
+    }
+    if (unionCount + 1 != trailCount)
+    {
+        return {}; // the edges are not connected
+    }
+
+    // 4) output: the start arc becomes a splitter too, then segments -> ring prefix sum -> parallel writes
+    const Arc startArc = offset[start];
+    if (!isSplitter(startArc))
+    {
+        splitterArc[ranks] = startArc;
+    }
+    auto isOutSplitter = [&](Arc a) { return a == startArc || isSplitter(a); };
+    auto outRank = [&](Arc a) { return isSplitter(a) ? rankOf(a) : ranks; };
+    run_on_threads(T, [&](unsigned t)
+    {
+        auto [first, last] = part_range(ranks + 1, T, t);
+        for (std::size_t r = first; r < last; ++r)
+        {
+            Arc a = splitterArc[r], len = 0;
+            if (a == NONE)
+            {
+                continue;
+            }
+            do
+            {
+                ++len;
+                a = next[a];
+            } while (!isOutSplitter(a));
+            segNext[r] = outRank(a);
+            segLen[r] = len;
+        }
+    });
+
+    std::vector<std::size_t> segPos(ranks + 1, NONE);
+    const Arc head = outRank(startArc);
+    std::size_t pos = 0;
+    Arc r = head;
+    do
+    {
+        segPos[r] = pos;
+        pos += segLen[r];
+        r = segNext[r];
+    } while (r != head);
+    if (pos != edges)
+    {
+        return {};
+    }
+
+    std::vector<int> circuit(edges + 1);
+    run_on_threads(T, [&](unsigned t)
+    {
+        auto [first, last] = part_range(ranks + 1, T, t);
+        for (std::size_t r = first; r < last; ++r)
+        {
+            if (segPos[r] == NONE)
+            {
+                continue;
+            }
+            Arc a = splitterArc[r];
+            int u = static_cast<int>(std::upper_bound(offset.begin(), offset.end(), a) - offset.begin()) - 1;
+            std::size_t p = segPos[r];
+            for (Arc i = 0; i < segLen[r]; ++i)
+            {
+                circuit[p++] = u;
+                u = g.get_neighbors(u)[a - offset[u]];
+                a = next[a];
+            }
+        }
+    });
+    circuit[edges] = start;
+    return circuit;
+}
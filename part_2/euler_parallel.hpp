@@ -0,0 +1,50 @@
+/*
+@author: Roy Meoded
+@author: Yarin Keshet
+
+@ description: Multi-threaded Eulerian circuit construction for very large graphs (directed or undirected).
+Hierholzer (euler_circle.hpp) follows one edge at a time; here every phase is a parallel loop:
+1. Pairing: at every vertex, every arriving edge end is paired with a leaving one (undirected: consecutive
+   entries of the neighbor list; directed: the k-th in-arc with the k-th out-arc). Following the pairs splits
+   the edges into closed trails, decided locally per vertex.
+2. Labeling: every trail gets an id. Every 64th arc is a splitter; every thread walks from its splitters to
+   the next splitter, and only the short ring of splitters is scanned sequentially. Trails without a splitter
+   are labeled by the thread owning their smallest arc.
+3. Merging: at every vertex, the trails passing through it are joined with a concurrent union-find; for the
+   pairs whose union succeeded the pairs are rotated (each arrival now leaves along the next trail), which
+   splices those trails into one. The successful unions form a forest, so the result is a single circuit
+   exactly when the edges are connected.
+4. Output: list ranking over the splitters of the final circuit (segment lengths in parallel, a prefix sum
+   over the ring, then every thread writes its segments).
+The only sequential passes are O(V) or O(E/64); pairing the two arcs of an undirected edge sorts every
+neighbor list (in parallel), so the whole run is O(E log d) work.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "../part_1/graph_impl.hpp"
+
+class ParallelEulerCircle
+{
+public:
+    // threads = 0: one per core (fewer for small graphs, see threads_for)
+    explicit ParallelEulerCircle(const Graph& graph, unsigned threads = 0) : g(graph), requested(threads) {}
+
+    /*
+    Same contract as EulerCircle::eulerianCircuit: a vertex sequence with first == last starting at the first
+    vertex with an edge, empty if there is no circuit, {0} for a graph without edges. The circuit may differ
+    from the sequential one (and between runs with several threads).
+    Throws length_error for 2^32 - 1 arcs or more.
+    */
+    std::vector<int> eulerianCircuit() const;
+
+    // Number of threads eulerianCircuit() would use for this many arcs
+    unsigned threads_for(std::size_t arcs) const;
+
+private:
+    const Graph& g;
+    unsigned requested;
+};
@@ -1,6 +1,7 @@
 #include <iostream>
 #include "../part_1/graph_impl.hpp"
 #include "../part_2/euler_circle.hpp"
+#include "../part_2/euler_parallel.hpp"
 
 // Example usage
 int main() 
@@ -30,6 +31,14 @@ int main()
         std::cout << "\nChecking for Eulerian circuit (Case A):\n";
         EulerCircle ec(g);
         ec.findEulerianCircuit();
+
+        // Same graph through the parallel construction (a single thread at this size)
+        std::cout << "Parallel Eulerian circuit: ";
+        for (int v : ParallelEulerCircle(g).eulerianCircuit())
+        {
+            std::cout << v << " ";
+        }
+        std::cout << std::endl;
     }
 
     // ===== Case B: Disconnected graph (not Eulerian) =====
@@ -73,5 +82,32 @@ int main()
         ec.findEulerianCircuit();
     }
 
+    // ===== Case E: Directed graph, balanced in/out degrees (Eulerian) =====
+    {
+        Graph g(4, true);
+        g.addEdge(0, 1); g.addEdge(1, 2); g.addEdge(2, 0);
+        g.addEdge(2, 3); g.addEdge(3, 2);
+
+        std::cout << "\nGraph adjacency list (Case E, directed):\n";
+        g.print();
+
+        std::cout << "\nChecking for Eulerian circuit (Case E):\n";
+        EulerCircle ec(g);
+        ec.findEulerianCircuit();
+    }
+
+    // ===== Case F: Directed graph with an Eulerian path only =====
+    {
+        Graph g(4, true);
+        g.addEdge(0, 1); g.addEdge(1, 2); g.addEdge(2, 1); g.addEdge(1, 3);
+
+        std::cout << "\nGraph adjacency list (Case F, directed):\n";
+        g.print();
+
+        std::cout << "\nChecking for Eulerian circuit (Case F):\n";
+        EulerCircle ec(g);
+        ec.findEulerianCircuit();
+    }
+
     return 0;
 }
@@ -1,17 +1,21 @@
 #include "random_graph.hpp"
+#include "../part_1/graph_builder.hpp"
+#include "../part_1/thread_utils.hpp"
 #include <random>
 #include <set>
 #include <algorithm>
+#include <thread>
 
-Graph generate_random_graph(int vertices, int edges, int seed)
+// Version 1: pairs drawn with std::mt19937 until `edges` distinct ones were found (see edge_sampling.hpp)
+static std::vector<GraphEdge> rejection_edges(int vertices, int edges, int seed)
 {
-    Graph g(vertices, false); // undirected
-
     // Initialize RNG
     std::mt19937 rng(seed); //helps in generating different graphs for different seeds
     std::uniform_int_distribution<int> dist(0, vertices - 1);
 
     std::set<std::pair<int,int>> used; //for preventing duplicate edges
+    std::vector<GraphEdge> list; // collected edges, turned into the graph by the parallel builder
+    list.reserve(edges);
     int added = 0;
 
     while (added < edges) 
@@ -26,10 +30,144 @@ Graph generate_random_graph(int vertices, int edges, int seed)
         auto e = std::make_pair(std::min(u, v), std::max(u, v));
         if (used.count(e)) continue; // skip duplicates
 
-        g.addEdge(u, v);
+        list.push_back({u, v, 1});
         used.insert(e);
         ++added;
     }
+    return list;
+}
+
+Graph generate_random_graph(int vertices, int edges, int seed, unsigned threads, GeneratorVersion version)
+{
+    if (vertices <= 0)
+    {
+        throw std::invalid_argument("number of vertices must be positive");
+    }
+    if (edges < 0 || static_cast<std::uint64_t>(edges) > pair_count(vertices, false))
+    {
+        throw std::invalid_argument("number of edges must be between 0 and V(V-1)/2");
+    }
 
-    return g;
-}
\ No newline at end of file
+    std::vector<GraphEdge> list;
+    if (version == GeneratorVersion::Rejection)
+    {
+        list = rejection_edges(vertices, edges, seed);
+    }
+    else if (version == GeneratorVersion::Parallel)
+    {
+        // Version 3: the same sampling over Philox blocks, drawn and decoded on `threads` threads
+        std::vector<std::uint64_t> picked =
+            parallel_sample_indices(pair_count(vertices, false), edges, static_cast<std::uint64_t>(seed), threads);
+        list.resize(picked.size());
+        parallel_decode(picked, vertices, false, threads, [&](std::size_t i, int u, int v) { list[i] = {u, v, 1}; });
+    }
+    else
+    {
+        // Version 2: a uniform set of `edges` pair indices, sorted, decoded row by row
+        std::mt19937_64 rng(static_cast<std::uint64_t>(seed));
+        std::vector<std::uint64_t> picked = sample_indices(pair_count(vertices, false), edges, rng);
+        list.reserve(picked.size());
+        PairDecoder pair(vertices, false);
+        for (std::uint64_t index : picked)
+        {
+            auto [u, v] = pair(index);
+            list.push_back({u, v, 1});
+        }
+    }
+    GraphBuildOptions options;
+    options.threads = threads;
+    return build_graph_parallel(vertices, false, list, options); // undirected
+}
+
+Graph generate_gnp_graph(int vertices, double p, int seed, unsigned threads, GeneratorVersion version)
+{
+    if (vertices <= 0)
+    {
+        throw std::invalid_argument("number of vertices must be positive");
+    }
+    if (!(p >= 0.0 && p <= 1.0))
+    {
+        throw std::invalid_argument("edge probability must be in [0, 1]");
+    }
+    std::vector<GraphEdge> list;
+    if (version == GeneratorVersion::Parallel)
+    {
+        std::vector<std::uint64_t> picked =
+            parallel_bernoulli_indices(pair_count(vertices, false), p, static_cast<std::uint64_t>(seed), threads);
+        list.resize(picked.size());
+        parallel_decode(picked, vertices, false, threads, [&](std::size_t i, int u, int v) { list[i] = {u, v, 1}; });
+    }
+    else
+    {
+        std::mt19937_64 rng(static_cast<std::uint64_t>(seed));
+        list.reserve(static_cast<std::size_t>(p * static_cast<double>(pair_count(vertices, false)) * 1.05) + 16);
+        PairDecoder pair(vertices, false);
+        bernoulli_indices(pair_count(vertices, false), p, rng, [&](std::uint64_t index)
+        {
+            auto [u, v] = pair(index);
+            list.push_back({u, v, 1});
+        });
+    }
+    GraphBuildOptions options;
+    options.threads = threads;
+    return build_graph_parallel(vertices, false, list, options);
+}
+
+Graph generate_model_graph(const GraphModel& model, int vertices, int edges, int seed, unsigned threads)
+{
+    if (model.kind == GraphModel::Uniform)
+    {
+        return generate_random_graph(vertices, edges, seed, threads);
+    }
+    std::vector<GraphEdge> list = model_edges(model, vertices, edges, false, static_cast<std::uint64_t>(seed), threads);
+    GraphBuildOptions options;
+    options.threads = threads;
+    return build_graph_parallel(vertices, false, list, options);
+}
+
+/*
+Segment t walks from anchor[t] to anchor[t + 1] (anchor[T] = anchor[0]) in at least 2 steps: every step goes to
+a random vertex other than the current one, the one before the last also avoids the next anchor, so the final
+step into the anchor is not a self-loop. The segments together are one closed walk.
+*/
+Graph generate_eulerian_graph(int vertices, int edges, int seed, bool directed, unsigned threads)
+{
+    if (vertices < 3 || edges < 3)
+    {
+        throw std::invalid_argument("an Eulerian test graph needs at least 3 vertices and 3 edges");
+    }
+    unsigned T = threads ? threads : std::max(1u, std::thread::hardware_concurrency());
+    T = std::max(1u, std::min<unsigned>(T, static_cast<unsigned>(edges / 2)));
+
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> dist(0, vertices - 1);
+    std::vector<int> anchor(T + 1);
+    for (unsigned t = 0; t < T; ++t)
+    {
+        anchor[t] = dist(rng);
+    }
+    anchor[T] = anchor[0];
+
+    std::vector<GraphEdge> list(edges);
+    run_on_threads(T, [&](unsigned t)
+    {
+        auto [first, last] = part_range(static_cast<std::size_t>(edges), T, t);
+        std::mt19937 local(static_cast<unsigned>(seed) * 2654435761u + t + 1); // independent stream per segment
+        std::uniform_int_distribution<int> pick(0, vertices - 1);
+        int cur = anchor[t];
+        for (std::size_t i = first; i + 1 < last; ++i)
+        {
+            int next;
+            do
+            {
+                next = pick(local);
+            } while (next == cur || (i + 2 == last && next == anchor[t + 1]));
+            list[i] = {cur, next, 1};
+            cur = next;
+        }
+        list[last - 1] = {cur, anchor[t + 1], 1};
+    });
+    GraphBuildOptions options;
+    options.threads = threads;
+    return build_graph_parallel(vertices, directed, list, options);
+}
@@ -11,6 +11,31 @@ This file includes the Graph class from part_1/graph_impl.hpp to utilize its gra
 
 #pragma once
 #include "../part_1/graph_impl.hpp"
+#include "../part_1/edge_sampling.hpp"
+#include "../part_1/graph_models.hpp"
 
 // Generate a random undirected graph with given number of vertices, edges, and seed
-Graph generate_random_graph(int vertices, int edges, int seed);
+// (threads: threads used to draw the edges (Parallel version) and build the adjacency lists, 0 = one per core,
+// see graph_builder.hpp; version: the algorithm a seed is replayed with, see edge_sampling.hpp; Sampled and
+// Parallel are O(V+E), and a Parallel graph is the same for every thread count)
+// Throws invalid_argument when edges is negative or more than V(V-1)/2.
+Graph generate_random_graph(int vertices, int edges, int seed, unsigned threads = 0,
+                            GeneratorVersion version = GeneratorVersion::Latest);
+
+// G(n,p): a random undirected graph where every pair of distinct vertices is an edge with probability p, O(V+E)
+// (version Parallel draws on several threads; Rejection and Sampled both mean the one-thread sampler)
+Graph generate_gnp_graph(int vertices, double p, int seed, unsigned threads = 0,
+                         GeneratorVersion version = GeneratorVersion::Latest);
+
+// Undirected graph of a benchmark family (R-MAT, Barabasi-Albert, grids, planted cliques: graph_models.hpp);
+// the Uniform model is generate_random_graph with the latest version
+Graph generate_model_graph(const GraphModel& model, int vertices, int edges, int seed, unsigned threads = 0);
+
+/*
+Generate a random connected Eulerian graph (every degree even / in-degree == out-degree) with exactly `edges`
+edges: one closed random walk over the vertices, without self-loops (parallel edges are possible and vertices
+the walk misses stay isolated). The walk is cut into one segment per thread between random anchor vertices,
+so the edges are drawn in parallel; the graph is deterministic for a given seed and thread count.
+Throws invalid_argument for fewer than 3 vertices or 3 edges. Meant for the Euler benchmarks (part_2).
+*/
+Graph generate_eulerian_graph(int vertices, int edges, int seed, bool directed = false, unsigned threads = 0);
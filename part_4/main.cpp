@@ -1,15 +1,28 @@
 #include "../part_1/graph_impl.hpp"
+#include "../part_1/graph_file.hpp"
 #include "../part_2/euler_circle.hpp"
 #include "../part_3/random_graph.hpp"
 
 #include <iostream>
 #include <unistd.h> // for getopt
 #include <cstdlib> // for std::atoi
+#include <string>
+#include <stdexcept>
 
 /*
 instructions to run the main demo:
 to run the main write this line:
 ./main -v <vertices> -e <edges> -s $(date +%s)
+optional:
+-o <file>  save the generated graph to a binary graph file
+-f <file>  load a graph from a binary graph file instead of generating one (-v/-e/-s are ignored)
+-t <n>     threads used to build the generated graph (default: one per core)
+-p <prob>  G(n,p) instead of a fixed edge count: every pair is an edge with probability prob (-e is ignored)
+-g <ver>   generator version to replay a seed with (1 = rejection sampling, 2 = O(V+E) sampling,
+           3 = O(V+E) sampling on -t threads with the same graph for every thread count, the default)
+-m <model> benchmark graph family instead of a uniform graph (see part_1/graph_models.hpp):
+           rmat[:a,b,c] | ba[:m] | grid2d | grid3d | cliques:size[,count] (-e: R-MAT edges, BA edges/vertex
+           when m is not given, background edges of the planted cliques; grids ignore it)
 */
 
 int main(int argc, char* argv[]) 
@@ -17,10 +30,16 @@ int main(int argc, char* argv[])
     int vertices = 0;
     int edges = 0;
     int seed = 0;
+    std::string loadPath; // -f
+    std::string savePath; // -o
+    unsigned threads = 0; // -t, 0 = one per core
+    double probability = -1; // -p, G(n,p) when set
+    int version = static_cast<int>(GeneratorVersion::Latest); // -g
+    std::string modelSpec; // -m
     int opt;
 
     // Parse command-line arguments
-    while ((opt = getopt(argc, argv, "v:e:s:")) != -1) //getopt returns the character of the option found
+    while ((opt = getopt(argc, argv, "v:e:s:f:o:t:p:g:m:")) != -1) //getopt returns the character of the option found
     {
         switch (opt) 
         {
@@ -34,18 +53,86 @@ int main(int argc, char* argv[])
             case 's':
                 seed = std::atoi(optarg);
                 break;
+            case 'f':
+                loadPath = optarg;
+                break;
+            case 'o':
+                savePath = optarg;
+                break;
+            case 't':
+                threads = static_cast<unsigned>(std::atoi(optarg));
+                break;
+            case 'p':
+                probability = std::atof(optarg);
+                break;
+            case 'g':
+                version = std::atoi(optarg);
+                break;
+            case 'm':
+                modelSpec = optarg;
+                break;
             default:
-                std::cerr << "Usage: " << argv[0] << " -v <vertices> -e <edges> -s <seed>\n";
+                std::cerr << "Usage: " << argv[0] << " -v <vertices> (-e <edges> | -p <probability>) -s <seed> [-g <version> | -m <model>] [-t <threads>] [-o <file>] | -f <file>\n";
                 return 1;
         }
     }
 
-    std::cout << "Vertices: " << vertices << "\n";
-    std::cout << "Edges: " << edges << "\n";
-    std::cout << "Seed: " << seed << "\n";
+    // Pre-built graph: map and validate the file instead of generating, then copy it into a Graph for EulerCircle
+    if (!loadPath.empty())
+    {
+        try
+        {
+            MappedGraph mapped(loadPath);
+            std::cout << "File: " << loadPath << "\n";
+            std::cout << "Vertices: " << mapped.get_vertices() << "\n";
+            std::cout << "Edges: " << mapped.get_edges() << "\n";
+            Graph g = mapped.to_graph();
+            EulerCircle ec(g);
+            ec.findEulerianCircuit();
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "Error: " << e.what() << "\n";
+            return 1;
+        }
+        return 0;
+    }
 
     // Next steps: generate random graph and run EulerCircle...
-    Graph g = generate_random_graph(vertices, edges, seed);
+    Graph g(1, false);
+    try
+    {
+        if (!modelSpec.empty())
+        {
+            g = generate_model_graph(parse_graph_model(modelSpec), vertices, edges, seed, threads);
+        }
+        else
+        {
+            g = probability >= 0 ? generate_gnp_graph(vertices, probability, seed, threads, generator_version(version))
+                                 : generate_random_graph(vertices, edges, seed, threads, generator_version(version));
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    std::cout << "Vertices: " << vertices << "\n";
+    std::cout << "Edges: " << g.get_edges() << "\n";
+    std::cout << "Seed: " << seed << "\n";
+    if (!savePath.empty())
+    {
+        try
+        {
+            save_graph_binary(g, savePath);
+            std::cout << "Saved graph to " << savePath << "\n";
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "Error: " << e.what() << "\n";
+            return 1;
+        }
+    }
     EulerCircle ec(g);
     ec.findEulerianCircuit();
 
@@ -1,13 +1,46 @@
 #!/bin/bash
 
+# Cases that must fail are run as "! ./main ...", so the script exits 0 when every case behaves
+
 # Test: insufficient arguments(default is zero in all arguments)
-./main
+! ./main
 
 # Test: argument usage is invalid
-./main -v 4 -e 4 -z 42
+! ./main -v 4 -e 4 -z 42
 
-# Test: valid graph with Eulerian circuit
-./main -v 4 -e 4 -s 4
+# Test: valid graph with Eulerian circuit (the seeds below were picked with the original generator, -g 1)
+./main -v 4 -e 4 -s 4 -g 1
 
 # Test: valid graph without Eulerian circuit
-./main -v 4 -e 4 -s 42
\ No newline at end of file
+./main -v 4 -e 4 -s 42 -g 1
+# Test: save a generated graph to a binary file, then start from the file
+./main -v 4 -e 4 -s 4 -g 1 -o test_graph.graph
+./main -f test_graph.graph
+
+# Test: missing / invalid graph file
+! ./main -f missing.graph
+! ./main -f run_tests.sh
+rm -f test_graph.graph
+
+# Test: explicit number of builder threads
+./main -v 6 -e 8 -s 4 -g 1 -t 2
+
+# Test: G(n,p), the original (version 1) generator, an unknown version, too many edges
+./main -v 8 -p 0.5 -s 4
+./main -v 4 -e 4 -s 4 -g 1
+! ./main -v 4 -e 4 -s 4 -g 9
+! ./main -v 4 -e 7 -s 4
+
+# Test: the one-thread sampler (version 2) and the parallel one (version 3) on several threads
+./main -v 6 -e 8 -s 4 -g 2
+./main -v 6 -e 8 -s 4 -g 3 -t 3
+
+# Test: benchmark graph families, and an unknown / invalid model (R-MAT probabilities that never give an edge below V)
+./main -v 16 -e 40 -s 4 -m rmat
+./main -v 12 -e 24 -s 4 -m ba:2
+./main -v 9 -s 4 -m grid2d
+./main -v 27 -s 4 -m grid3d
+./main -v 10 -e 5 -s 4 -m cliques:4
+! ./main -v 10 -e 5 -s 4 -m tree
+! ./main -v 3 -s 4 -m ba:3
+! ./main -v 3 -e 2 -s 1 -m rmat:0,1,0
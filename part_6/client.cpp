@@ -204,16 +204,25 @@ void run_client()
         // Sending Graph Data and Receiving Response
         send(sock, graph_data.c_str(), graph_data.size(), 0);
         /*
-        Reads up to 4096 bytes of data from the server through the socket sock.
-        The data is stored in the buffer array.
+        Reads the response 4096 bytes at a time until its "END" line (the server keeps the connection
+        open for further requests; long circuits are streamed in several pieces).
         valread will contain the number of bytes actually read (could be less than 4096).
         */
-        int valread = read(sock, buffer, 4096);
-        /*
-        Converts the received bytes in buffer to a string (using only the bytes actually read).
-        Prints the server’s response to the user.
-        */
-        std::cout << "Server response:\n" << std::string(buffer, valread) << std::endl;
+        std::string response;
+        int valread;
+        const std::string end_line = "END\n";
+        while ((valread = read(sock, buffer, 4096)) > 0)
+        {
+            response.append(buffer, valread);
+            if (response.size() >= end_line.size() &&
+                response.compare(response.size() - end_line.size(), end_line.size(), end_line) == 0)
+            {
+                response.erase(response.size() - end_line.size());
+                break;
+            }
+        }
+        // Prints the server’s response to the user.
+        std::cout << "Server response:\n" << response << std::endl;
 
         close(sock); // Close the socket
 
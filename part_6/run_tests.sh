@@ -19,12 +19,12 @@ send_raw() {
   local errfile="$3"
 
   if command -v nc >/dev/null 2>&1; then
-    printf "%s" "$payload" | nc -q 1 127.0.0.1 8080 >"$outfile" 2>"$errfile" || true
+    printf "%b" "$payload" | nc -q 1 127.0.0.1 8080 >"$outfile" 2>"$errfile" || true
   else
     # Fallback: /dev/tcp (Bash)
     exec 3<>/dev/tcp/127.0.0.1/8080 || true
     if [ -e /proc/$$/fd/3 ]; then
-      printf "%s" "$payload" >&3
+      printf "%b" "$payload" >&3
       timeout 2s cat <&3 >"$outfile" 2>"$errfile" || true
       exec 3>&- 3<&-
     else
@@ -219,6 +219,9 @@ send_raw "5 6\n0 1\n1 2\n2 3\n3 4\n4 0\n1 3\n" build/raw_many_edges.out build/ra
 echo "[30] RAW: Parse failure (non-numeric start)"
 send_raw "abc xyz\n" build/raw_parse_fail.out build/raw_parse_fail.err
 
+echo "[30b] RAW: Two requests on one connection (one END-terminated response each)"
+send_raw "3 3\n0 1\n1 2\n2 0\n4 2 0 1\n2 3\n" build/raw_two_requests.out build/raw_two_requests.err
+
 # --------- Clean shutdown of the main server ---------
 echo "[31] EXIT_CLIENT to close main server (clean coverage flush)"
 timeout 6s ./client > /dev/null 2>&1 <<'EOF'
@@ -1,4 +1,8 @@
 #include "server.hpp"
+#include <cerrno>
+#include <algorithm>
+#include <cctype>
+#include <climits>
 #include <cstdlib> // getenv
 
 // Wrapper for exit that can be suppressed during cumulative coverage runs.
@@ -12,6 +16,328 @@ static void coverage_exit(int code)
     exit(code);
 }
 
+// Send all of data (send() may write less than asked for); returns the number of bytes sent
+static std::size_t send_all(int fd, const std::string& data)
+{
+    std::size_t sent = 0;
+    while (sent < data.size())
+    {
+        ssize_t n = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (n <= 0)
+        {
+            break; // client went away
+        }
+        sent += static_cast<std::size_t>(n);
+    }
+    return sent;
+}
+
+/*
+Whitespace-separated tokens of one connection. The socket is read RECV_CHUNK bytes at a time, so a request
+may be split over any number of packets and a token may span two reads.
+A token longer than MAX_TOKEN characters (no number or keyword of the protocol is) is not collected:
+next() fails with overlong() set, so a peer that never sends whitespace cannot grow the server's memory.
+*/
+class TokenReader
+{
+public:
+    explicit TokenReader(int fd) : fd(fd), buffer(RECV_CHUNK) {}
+
+    // Next token; false if the stream ended (EOF, error or receive timeout) before one started, or it was too long
+    bool next(std::string& token)
+    {
+        token.clear();
+        while (true)
+        {
+            if (pos == len && !fill())
+            {
+                return !token.empty();
+            }
+            while (pos < len)
+            {
+                char c = buffer[pos++];
+                if (!std::isspace(static_cast<unsigned char>(c)))
+                {
+                    if (token.size() == MAX_TOKEN)
+                    {
+                        tooLong = true;
+                        return false;
+                    }
+                    token += c;
+                }
+                else if (!token.empty())
+                {
+                    return true;
+                }
+            }
+        }
+    }
+
+    bool overlong() const { return tooLong; }
+
+    // Bytes received but not consumed yet (the start of a pipelined request)
+    bool buffered() const { return pos < len; }
+
+private:
+    bool fill()
+    {
+        while (true)
+        {
+            ssize_t n = recv(fd, buffer.data(), buffer.size(), 0);
+            if (n < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            pos = 0;
+            len = n > 0 ? static_cast<std::size_t>(n) : 0;
+            return n > 0;
+        }
+    }
+
+    int fd;
+    std::vector<char> buffer;
+    std::size_t pos = 0, len = 0;
+    bool tooLong = false;
+};
+
+// One client connection: its socket, the reader that keeps its unread bytes, and since when it is idle
+struct Connection
+{
+    explicit Connection(int fd) : fd(fd), in(fd) {}
+
+    int fd;
+    TokenReader in;
+    std::chrono::steady_clock::time_point idleSince = std::chrono::steady_clock::now();
+};
+
+/*
+Connections by state. A connection only holds a worker while one of its requests is read and answered:
+- idle: no request pending, watched by the poll() of the accept loop (g_idle),
+- waiting: a request is arriving, queued for a worker (g_waiting),
+- serving: a worker is reading/answering its request (g_serving).
+A worker puts the connection back to idle and wakes the accept loop through g_wake, so idle clients cost
+no thread and any number of them can stay connected.
+*/
+namespace
+{
+    std::mutex g_mu;
+    std::condition_variable g_cv;
+    std::deque<std::unique_ptr<Connection>> g_waiting;
+    std::vector<std::unique_ptr<Connection>> g_idle;
+    std::set<int> g_serving;    // shut down for reading when the server stops
+    bool g_shutdown = false;
+    int g_wake[2] = {-1, -1};   // pipe: a worker writes a byte when it hands a connection back
+    std::mutex g_log_mu;        // one log entry at a time on std::cout
+    long g_timeout_sec = 30;    // idle time before the server stops, and before an idle client is dropped
+}
+
+// Whole-token integer in int range
+static bool parse_int(const std::string& token, int& value)
+{
+    if (token.empty())
+    {
+        return false;
+    }
+    errno = 0;
+    char* end = nullptr;
+    long long v = std::strtoll(token.c_str(), &end, 10);
+    if (errno != 0 || *end != '\0' || v < INT_MIN || v > INT_MAX)
+    {
+        return false;
+    }
+    value = static_cast<int>(v);
+    return true;
+}
+
+// Every response ends with this line, so a client knows where it stops without the connection closing
+static const char* const END_LINE = "END\n";
+
+static void log_request(int V, int E, const std::string& result)
+{
+    std::lock_guard<std::mutex> lk(g_log_mu);
+    std::cout << "Received from client: " << V << " vertices, " << E << " edges" << std::endl;
+    std::cout << "Response sent:\n" << result << std::endl;
+}
+
+/*
+Reads and answers one request of the connection. Returns false when the connection has to be closed:
+the client is done (EOF, EXIT_CLIENT), or the request could not be framed (malformed header, a non-numeric
+or missing edge), since the next request could not be found in the stream.
+An out-of-range edge only fails its own request: the remaining edges are still read.
+*/
+static bool serve_request(int fd, TokenReader& in)
+{
+    std::string token, second;
+    if (!in.next(token))
+    {
+        if (in.overlong())
+        {
+            std::string result = "Error: Malformed request: token longer than " + std::to_string(MAX_TOKEN) + " characters.\n";
+            log_request(0, 0, result);
+            send_all(fd, result + END_LINE);
+        }
+        return false;
+    }
+    if (token == "EXIT_CLIENT")
+    {
+        std::lock_guard<std::mutex> lk(g_log_mu);
+        std::cout << "Client exited." << std::endl;
+        return false;
+    }
+
+    int V = 0, E = 0;
+    if (!parse_int(token, V) || !in.next(second) || !parse_int(second, E))
+    {
+        std::string result = "Error: Malformed request: expected \"V E\" followed by E edges.\n";
+        log_request(V, E, result);
+        send_all(fd, result + END_LINE);
+        return false;
+    }
+
+    std::ostringstream msg;
+    if (V <= 0)
+    {
+        msg << "Error: Number of vertices must be positive.\n";
+    }
+    else if (E < 0)
+    {
+        msg << "Error: Number of edges cannot be negative.\n";
+    }
+    if (E < 0)
+    {
+        log_request(V, E, msg.str());
+        send_all(fd, msg.str() + END_LINE);
+        return false;
+    }
+
+    // The edges are read even after an invalid one, so that the next request starts where this one ends
+    std::vector<GraphEdge> edges; // validated edges, added with one bulk call
+    edges.reserve(std::min(E, 1 << 20));
+    bool valid = V > 0;
+    for (int i = 0; i < E; ++i)
+    {
+        int u = 0, v = 0;
+        if (!in.next(token) || !in.next(second))
+        {
+            std::string result = in.overlong()
+                ? "Error: Malformed request: token longer than " + std::to_string(MAX_TOKEN) + " characters.\n"
+                : "Error: Incomplete edge list: expected " + std::to_string(E) + " edges, received " + std::to_string(i) + ".\n";
+            log_request(V, E, result);
+            send_all(fd, result + END_LINE);
+            return false;
+        }
+        if (!parse_int(token, u) || !parse_int(second, v))
+        {
+            std::string result = "Error: Malformed edge (" + token + ", " + second + "). Vertices must be integers.\n";
+            log_request(V, E, result);
+            send_all(fd, result + END_LINE);
+            return false;
+        }
+        if (!valid)
+        {
+            continue;
+        }
+        if (u < 0 || v < 0 || u >= V || v >= V)
+        {
+            msg << "Error: Invalid edge (" << u << ", " << v << "). Vertices must be in range 0 to " << V - 1 << ".\n";
+            valid = false;
+            continue;
+        }
+        edges.push_back({u, v, 1});
+    }
+
+    if (valid)
+    {
+        Graph g(V, false); // false for undirected
+        g.addEdges(edges);
+        std::vector<GraphEdge>().swap(edges);
+        msg << "Welcome to the Euler Graph Server!\n";
+        msg << "Vertices: " << V << "\n";
+        msg << "Edges: " << E << "\n";
+
+        // The circuit goes to the socket in pieces of at most SEND_CHUNK bytes while it is produced
+        EulerCircle ec(g);
+        std::string pending = msg.str() + "Eulerian circuit: ";
+        std::size_t bytes = 0, vertices = 0;
+        bool streamed = ec.streamEulerianCircuit([&](const int* circuit, std::size_t count)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                pending += std::to_string(circuit[i]);
+                pending += ' ';
+                if (pending.size() >= SEND_CHUNK)
+                {
+                    bytes += send_all(fd, pending);
+                    pending.clear();
+                }
+            }
+            vertices += count;
+        });
+        if (streamed)
+        {
+            pending += '\n';
+            pending += END_LINE;
+            bytes += send_all(fd, pending);
+            msg << "Eulerian circuit: <streamed, " << vertices << " vertices, " << bytes << " bytes>\n";
+            log_request(V, E, msg.str());
+            return true;
+        }
+        // No circuit: only the (short) diagnostics
+        ec.findEulerianCircuit(msg);
+    }
+    std::string result = msg.str();
+    log_request(V, E, result);
+    send_all(fd, result + END_LINE);
+    return true;
+}
+
+bool handle_client(Connection& c)
+{
+    return serve_request(c.fd, c.in);
+}
+
+// Worker of the pool: serves one request of a waiting connection at a time until the server stops
+static void worker_loop()
+{
+    while (true)
+    {
+        std::unique_ptr<Connection> c;
+        {
+            std::unique_lock<std::mutex> lk(g_mu);
+            g_cv.wait(lk, [] { return g_shutdown || !g_waiting.empty(); });
+            if (g_waiting.empty())
+            {
+                return; // shutdown, nothing left to serve
+            }
+            c = std::move(g_waiting.front());
+            g_waiting.pop_front();
+            g_serving.insert(c->fd);
+        }
+        bool open = handle_client(*c);
+        std::unique_lock<std::mutex> lk(g_mu);
+        g_serving.erase(c->fd);
+        if (!open || g_shutdown)
+        {
+            lk.unlock();
+            close(c->fd);
+        }
+        else if (c->in.buffered())
+        {
+            g_waiting.push_back(std::move(c)); // the next request is already here
+            lk.unlock();
+            g_cv.notify_one();
+        }
+        else
+        {
+            c->idleSince = std::chrono::steady_clock::now();
+            g_idle.push_back(std::move(c));
+            lk.unlock();
+            char byte = 0;
+            (void)!write(g_wake[1], &byte, 1); // the accept loop polls the new idle connection
+        }
+    }
+}
+
 void run_server()
 {
     // Main variables for socket setup & client handling.
@@ -19,7 +345,6 @@ void run_server()
     struct sockaddr_in address;
     int opt = 1; // option for setsockopt
     int addrlen = sizeof(address);
-    char buffer[4096] = {0}; // buffer to store incoming data
 
     // Create socket file descriptor (TCP):
     int server_fd = socket(AF_INET, SOCK_STREAM, 0);
@@ -59,49 +384,118 @@ void run_server()
     }
 
 
-    // Start listening for incoming connections:
-    if (listen(server_fd, 3) < 0 || force_listen_err)
+    // Start listening for incoming connections (backlog of 64 pending connections):
+    if (listen(server_fd, 64) < 0 || force_listen_err)
     {
         perror("listen");
         coverage_exit(EXIT_FAILURE);
     }
     std::cout << "Server listening on port " << PORT << std::endl;
 
-    // Main server loop to accept and handle client connections:
+    // Timeout: default 30s, override with FAST_TIMEOUT env (used for quick gcov runs)
+    const char* fast_env = std::getenv("FAST_TIMEOUT");
+    if (fast_env) {
+        char* endp = nullptr;
+        long v = strtol(fast_env, &endp, 10);
+        if (endp != fast_env && v >= 0 && v < 3600) {
+            g_timeout_sec = v;
+        }
+    }
+
+    // Fixed pool of workers: hardware_concurrency() when available, but at least 4 threads.
+    unsigned workers = std::max(4u, std::thread::hardware_concurrency());
+    std::vector<std::thread> pool;
+    pool.reserve(workers);
+    for (unsigned i = 0; i < workers; ++i)
+    {
+        pool.emplace_back(worker_loop);
+    }
+
+    if (pipe(g_wake) < 0)
+    {
+        perror("pipe");
+        coverage_exit(EXIT_FAILURE);
+    }
+
+    // Main server loop: accept client connections and wait for the next request of the idle ones
+    const auto idle_limit = std::chrono::seconds(std::max(g_timeout_sec, 1L));
+    auto last_activity = std::chrono::steady_clock::now();
     while (true)
     {
-        fd_set readfds; //Define which fds to be monitored by select
-        FD_ZERO(&readfds); //Clear the set
-        FD_SET(server_fd, &readfds);
-
-        // Timeout: default 30s, override with FAST_TIMEOUT env (used for quick gcov runs)
-        struct timeval timeout;
-        const char* fast_env = std::getenv("FAST_TIMEOUT");
-        long timeout_sec = 30;
-        if (fast_env) {
-            char* endp = nullptr;
-            long v = strtol(fast_env, &endp, 10);
-            if (endp != fast_env && v >= 0 && v < 3600) {
-                timeout_sec = v;
+        std::vector<pollfd> fds = {{server_fd, POLLIN, 0}, {g_wake[0], POLLIN, 0}};
+        {
+            std::lock_guard<std::mutex> lk(g_mu);
+            for (const auto& c : g_idle)
+            {
+                fds.push_back({c->fd, POLLIN, 0});
             }
         }
-        timeout.tv_sec = timeout_sec;
-        timeout.tv_usec = 0;
 
-        // Wait for an incoming connection with timeout:
-        int activity = select(server_fd + 1, &readfds, nullptr, nullptr, &timeout);
+        // Wait for a connection, a request or a connection handed back, with timeout:
+        int activity = poll(fds.data(), fds.size(), static_cast<int>(std::min(g_timeout_sec, 1L) * 1000));
+        auto now = std::chrono::steady_clock::now();
 
-        if (activity == 0)
+        if (activity < 0 || force_select_err)
         {
-            std::cout << "No client connected for 30 seconds. Server shutting down." << std::endl;
+            if (activity < 0 && errno == EINTR && !force_select_err)
+            {
+                continue;
+            }
+            perror("poll");
+            // In original code select failure would break; keep same semantics.
             break;
         }
 
-        if (activity < 0 || force_select_err)
+        if (fds[1].revents & POLLIN)
         {
-            perror("select");
-            // In original code select failure would break; keep same semantics.
-            break;
+            char drain[64];
+            (void)!read(g_wake[0], drain, sizeof(drain));
+        }
+
+        bool busy = false;
+        {
+            std::lock_guard<std::mutex> lk(g_mu);
+            // Idle connections with a request (or EOF) arriving go to a worker, the ones idle for too long are dropped
+            std::size_t kept = 0, woken = 0;
+            for (auto& c : g_idle)
+            {
+                auto it = std::find_if(fds.begin() + 2, fds.end(), [&](const pollfd& p) { return p.fd == c->fd; });
+                if (it != fds.end() && it->revents != 0)
+                {
+                    g_waiting.push_back(std::move(c));
+                    ++woken;
+                }
+                else if (now - c->idleSince >= idle_limit)
+                {
+                    close(c->fd);
+                    c.reset();
+                }
+                else
+                {
+                    g_idle[kept++] = std::move(c);
+                }
+            }
+            g_idle.resize(kept);
+            for (std::size_t i = 0; i < woken; ++i)
+            {
+                g_cv.notify_one();
+            }
+            busy = !g_waiting.empty() || !g_serving.empty() || !g_idle.empty();
+        }
+        if (busy || activity > 0)
+        {
+            last_activity = now;
+        }
+
+        if (!(fds[0].revents & POLLIN))
+        {
+            if (now - last_activity >= std::chrono::seconds(g_timeout_sec))
+            {
+                std::lock_guard<std::mutex> log(g_log_mu);
+                std::cout << "No client connected for 30 seconds. Server shutting down." << std::endl;
+                break;
+            }
+            continue;
         }
 
         // Accept the incoming connection:
@@ -111,73 +505,50 @@ void run_server()
         {
             perror("accept");
             // Original code returned (terminating run). For coverage accumulation we break.
+            if (new_socket >= 0)
+            {
+                close(new_socket);
+            }
             break;
         }
 
-        int valread = read(new_socket, buffer, 4096); // Read data from client
-        std::string input(buffer, valread);
-
-        if (input == "EXIT_CLIENT")
+        // A request that stops arriving midway is given up after the idle timeout
+        struct timeval tv;
+        tv.tv_sec = std::max(g_timeout_sec, 1L);
+        tv.tv_usec = 0;
+        setsockopt(new_socket, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
         {
-            std::cout << "Client exited." << std::endl;
-            close(new_socket);
-            continue;
+            std::lock_guard<std::mutex> log(g_log_mu);
+            std::cout << "Client connected." << std::endl;
         }
 
-        std::cout << "Client connected." << std::endl;
-
-        // Parse input to construct the graph:
-        std::istringstream iss(input);
-        int V = 0, E = 0;
-        iss >> V >> E;
+        // The connection waits in the poll set until its first request arrives:
+        std::lock_guard<std::mutex> lk(g_mu);
+        g_idle.push_back(std::make_unique<Connection>(new_socket));
+    }
 
-        std::ostringstream msg;
-        if (V <= 0)
-        {
-            msg << "Error: Number of vertices must be positive.\n";
-        }
-        else if (E < 0)
+    // Stop the pool: waiting connections are still served, the ones being read from see EOF, idle ones are closed
+    {
+        std::lock_guard<std::mutex> lk(g_mu);
+        g_shutdown = true;
+        for (int fd : g_serving)
         {
-            msg << "Error: Number of edges cannot be negative.\n";
+            shutdown(fd, SHUT_RD);
         }
-        else
+        for (auto& c : g_idle)
         {
-            Graph g(V, false); // false for undirected
-            bool valid = true;
-            for (int i = 0; i < E; ++i)
-            {
-                int u, v;
-                iss >> u >> v;
-                if (u < 0 || v < 0 || u >= V || v >= V)
-                {
-                    msg << "Error: Invalid edge (" << u << ", " << v << "). Vertices must be in range 0 to " << V - 1 << ".\n";
-                    valid = false;
-                    break;
-                }
-                g.addEdge(u, v);
-            }
-            if (valid)
-            {
-                std::ostringstream oss;
-                std::streambuf *old_cout = std::cout.rdbuf(oss.rdbuf());
-                EulerCircle ec(g);
-                ec.findEulerianCircuit();
-                std::cout.rdbuf(old_cout);
-
-                msg << "Welcome to the Euler Graph Server!\n";
-                msg << "Vertices: " << V << "\n";
-                msg << "Edges: " << E << "\n";
-                msg << oss.str();
-            }
+            close(c->fd);
         }
-        std::string result = msg.str();
-
-        std::cout << "Received from client:\n" << input << std::endl;
-        std::cout << "Response sent:\n" << result << std::endl;
-
-        send(new_socket, result.c_str(), result.size(), 0); // Send response to client
-        close(new_socket);
+        g_idle.clear();
     }
+    g_cv.notify_all();
+    for (auto& t : pool)
+    {
+        t.join();
+    }
+    close(g_wake[0]);
+    close(g_wake[1]);
+    close(server_fd);
     return;
 }
 
@@ -186,7 +557,3 @@ int main()
     run_server();
     return 0;
 }
-
-
-
-
@@ -7,8 +7,17 @@
 @description: Header file for server implementation--> with TCP server, and PORT 8080.
 The server accecpt connection, reading request, build graph, and running Euler , and return answer.
 Using the important method run_server():
-- run_server(): Main server loop to accept and handle client connections.
-After 30 seconds of no client connection, the server will shut down.
+- run_server(): Main server loop: accepts client connections and polls the idle ones; a connection whose next
+  request starts arriving is handed to a fixed pool of workers, and given back to the poll set once answered.
+  A worker is only held while a request is read and answered, so idle clients never block other clients.
+- handle_client(): Serves the next request of one connection; false when the connection has to be closed.
+After 30 seconds of no client connection (and none still being served), the server will shut down; a client
+that stays idle that long is disconnected.
+
+Protocol: a request is "V E" followed by E edges "u v" (any whitespace, split over any number of packets;
+the header says how much to read, so there is no size limit; a single token longer than MAX_TOKEN characters
+is answered with a malformed-request error and the connection is closed). Every response ends with an "END" line, and
+the connection stays open for the next request. "EXIT_CLIENT" closes the connection without a response.
 */
 
 #pragma once
@@ -17,11 +26,25 @@ After 30 seconds of no client connection, the server will shut down.
 #include <sys/socket.h>
 #include <netinet/in.h>
 #include <unistd.h>
+#include <poll.h>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
 #include <vector>
 #include <sstream>
 #include "../part_1/graph_impl.hpp"
 #include "../part_2/euler_circle.hpp"
 
 #define PORT 8080 // Default port
+#define SEND_CHUNK 65536 // bytes per send() while a circuit is streamed
+#define RECV_CHUNK 65536 // bytes per recv() while a request is read
+#define MAX_TOKEN 32 // longest token accepted (numbers and keywords of the protocol are far shorter)
+
+struct Connection;
 
-void run_server(); 
+void run_server();
+bool handle_client(Connection& c);
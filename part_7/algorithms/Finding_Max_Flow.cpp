@@ -1,22 +1,91 @@
 #include "Finding_Max_Flow.hpp"
 
-int FindingMaxFlow::findMaxFlow(Graph& g, int source, int sink) 
+template <typename VertexT, typename G>
+static std::int64_t findMaxFlowImpl(const G& g, VertexT source, VertexT sink, std::pmr::memory_resource* scratch) 
 {
-    int V = g.get_vertices();
+    const std::size_t V = static_cast<std::size_t>(g.get_vertices());
+    if (graph_detail::is_negative(source) || static_cast<std::size_t>(source) >= V ||
+        graph_detail::is_negative(sink) || static_cast<std::size_t>(sink) >= V)
+    {
+        throw std::out_of_range("Vertex index out of range");
+    }
 
-    // Copy the capacity matrix from the graph
-    // Capacity[u][v] = capacity of edge u->v
-    std::vector<std::vector<int>> residual = g.get_capacity();
+    /*
+    Build the residual network as scratch arrays owned by this call, allocated from scratch (the graph
+    itself is only read, O(V+E) memory, no VxV matrix):
+    *Every edge u->v with capacity c becomes a forward arc (u->v, c) and a reverse arc (v->u, 0).
+    *Parallel u->v edges share one forward arc whose capacity is the last one in the list of u, the same
+    capacity get_capacity(u, v) reports (and the old capacity matrix held), so repeated edges are not summed.
+    lastArc/owner remember, per target, the arc the current tail vertex already has to it.
+    *Arcs are grouped by their tail vertex in CSR form: the arcs leaving u are [start[u], start[u+1]).
+    *rev[a] is the index of the arc paired with arc a, so pushing flow on a is
+    residual[a] -= f; residual[rev[a]] += f.
+    *Arc indices are size_t and residuals are 64-bit, so neither the arc count nor the capacities
+    of large graphs can overflow.
+    */
+    const std::size_t none = std::numeric_limits<std::size_t>::max();
+    std::pmr::vector<std::size_t> start(V + 1, 0, scratch);
+    std::pmr::vector<std::size_t> owner(V, none, scratch);   // owner[v] = last tail vertex seen with an arc to v
+    std::pmr::vector<std::size_t> lastArc(V, none, scratch); // lastArc[v] = that arc (while owner[v] is u)
+    for (VertexT u = 0; u < static_cast<VertexT>(V); ++u) 
+    {
+        for (auto v : g.get_neighbors(u)) 
+        {
+            if (owner[v] == static_cast<std::size_t>(u))
+            {
+                continue; // parallel edge, no arc of its own
+            }
+            owner[v] = static_cast<std::size_t>(u);
+            ++start[u + 1]; // forward arc leaves u
+            ++start[v + 1]; // reverse arc leaves v
+        }
+    }
+    for (std::size_t u = 0; u < V; ++u) 
+    {
+        start[u + 1] += start[u];
+    }
 
-    int maxFlow = 0;
-    std::vector<int> parent(V); // To store the path
+    std::pmr::vector<VertexT> to(start[V], scratch);            // to[a] = target vertex of arc a
+    std::pmr::vector<std::int64_t> residual(start[V], scratch); // residual[a] = remaining capacity of arc a
+    std::pmr::vector<std::size_t> rev(start[V], scratch);       // rev[a] = paired reverse arc of a
+    std::pmr::vector<std::size_t> pos(start.begin(), start.end() - 1, scratch); // next free arc slot of every vertex
+    std::fill(owner.begin(), owner.end(), none);
+    for (VertexT u = 0; u < static_cast<VertexT>(V); ++u) 
+    {
+        g.for_each_arc(u, [&](auto target, auto capacity) 
+        {
+            VertexT v = static_cast<VertexT>(target);
+            if (owner[v] == static_cast<std::size_t>(u))
+            {
+                residual[lastArc[v]] = capacity; // a later parallel edge: its capacity wins
+                return;
+            }
+            owner[v] = static_cast<std::size_t>(u);
+            std::size_t a = pos[u]++;
+            lastArc[v] = a;
+            std::size_t r = pos[v]++;
+            to[a] = v; residual[a] = capacity; rev[a] = r;
+            to[r] = u; residual[r] = 0;        rev[r] = a;
+        });
+    }
+
+    std::int64_t maxFlow = 0;
+    std::pmr::vector<VertexT> parent(V, scratch); // To store the path
+    std::pmr::vector<std::size_t> parentArc(V, scratch); // parentArc[v] = arc used to reach v
+    std::pmr::vector<char> visited(V, scratch); // visited[v] = v already reached by the current BFS
+    /*
+    BFS queue, allocated once for all augmentations: every vertex enters it at most once per BFS,
+    so V slots with a head and a tail index are enough, and each BFS only resets the indices.
+    (A queue built inside the lambda would take a new block from the monotonic scratch arena on every augmentation.)
+    */
+    std::pmr::vector<VertexT> queue(V, scratch);
 
     /*               
     Breadth-First Search (BFS) to find an augmenting path using a lambda function:
 
     *auto lets the compiler deduce the type.
     *[&] means the lambda captures all local variables by reference (so it can use and modify them).
-    *(int s, int t) are the parameters: s is the source node, t is the sink node.
+    *(VertexT s, VertexT t) are the parameters: s is the source node, t is the sink node.
     *-> bool means the lambda returns a boolean value.
 
     What does the lambda do?
@@ -26,36 +95,38 @@ int FindingMaxFlow::findMaxFlow(Graph& g, int source, int sink)
     *If it finds such a path, it returns true; otherwise, it returns false.
     *It also fills the parent vector so it's possible to reconstruct the path later.
     */
-    auto bfs = [&](int s, int t) -> bool 
+    auto bfs = [&](VertexT s, VertexT t) -> bool 
     {
         /*
-        This sets every element of the parent vector to -1.
-        parent is used to keep track of the path found by BFS.
-        Setting all values to -1 means "no parent assigned yet" (i.e., the node hasn't been visited).
+        This clears the visited flags.
+        parent is used to keep track of the path found by BFS, it is only meaningful for visited vertices
+        (a separate flag is used instead of a -1 parent, so unsigned vertex ids work too).
         */
-        std::fill(parent.begin(), parent.end(), -1); 
-        std::queue<int> q; // BFS queue
-        q.push(s); // Start BFS from source
+        std::fill(visited.begin(), visited.end(), 0); 
+        std::size_t head = 0, tail = 0; // queue[head, tail) holds the vertices still to process
+        queue[tail++] = s; // Start BFS from source
         parent[s] = s; // Mark source as visited
-        while (!q.empty()) 
+        visited[s] = 1;
+        while (head < tail) 
         {
             /*
-            q.front() gets the first element in the queue q (the current node to process in BFS).
-            int u = q.front(); assigns that node to the variable u.
-            q.pop(); removes that node from the queue, so it's possible to process the next one in the following iteration.
+            queue[head] is the first element in the queue (the current node to process in BFS).
+            head++ removes that node from the queue, so it's possible to process the next one in the following iteration.
             */
-            int u = q.front();
-            q.pop();
-            for (int v = 0; v < V; ++v) 
+            VertexT u = queue[head++];
+            for (std::size_t a = start[u]; a < start[u + 1]; ++a) 
             {
-                // Check if the parent of v is not assigned and there's available capacity
-                if (parent[v] == -1 && residual[u][v] > 0) 
+                VertexT v = to[a];
+                // Check if v was not visited yet and there's available capacity
+                if (!visited[v] && residual[a] > 0) 
                 {
+                    visited[v] = 1;
                     parent[v] = u; // Set parent of v to u (u-->v in the path)
+                    parentArc[v] = a;
                     if (v == t) {
                         return true; // If we reached the sink, return true
                     }
-                    q.push(v); // Add v to the BFS queue
+                    queue[tail++] = v; // Add v to the BFS queue
                 }
             }
         }
@@ -70,20 +141,51 @@ int FindingMaxFlow::findMaxFlow(Graph& g, int source, int sink)
     while (bfs(source, sink)) 
     {
         // Find minimum residual capacity along the path:
-        int path_flow = INT_MAX; // Initialize path flow to a large value
-        for (int v = sink; v != source; v = parent[v]) 
+        std::int64_t path_flow = std::numeric_limits<std::int64_t>::max(); // Initialize path flow to a large value
+        for (VertexT v = sink; v != source; v = parent[v]) 
         {
-            int u = parent[v];
-            path_flow = std::min(path_flow, residual[u][v]);
+            path_flow = std::min(path_flow, residual[parentArc[v]]);
         }
         // Update residual capacities
-        for (int v = sink; v != source; v = parent[v]) 
+        for (VertexT v = sink; v != source; v = parent[v]) 
         {
-            int u = parent[v];
-            residual[u][v] -= path_flow; // Decrease forward edge capacity
-            residual[v][u] += path_flow; // Increase reverse edge capacity
+            std::size_t a = parentArc[v];
+            residual[a] -= path_flow; // Decrease forward edge capacity
+            residual[rev[a]] += path_flow; // Increase reverse edge capacity
         }
         maxFlow += path_flow;
     }
     return maxFlow;
-}
\ No newline at end of file
+}
+
+template <typename VertexT, typename WeightT>
+std::int64_t FindingMaxFlow::findMaxFlow(const BasicGraph<VertexT, WeightT>& g,
+                                         typename BasicGraph<VertexT, WeightT>::VertexId source,
+                                         typename BasicGraph<VertexT, WeightT>::VertexId sink) 
+{
+    return findMaxFlowImpl<VertexT>(g, source, sink, scratch);
+}
+
+template <typename VertexT, typename WeightT>
+std::int64_t FindingMaxFlow::findMaxFlow(const ReorderedGraph<VertexT, WeightT>& g,
+                                         typename BasicGraph<VertexT, WeightT>::VertexId source,
+                                         typename BasicGraph<VertexT, WeightT>::VertexId sink) 
+{
+    return findMaxFlowImpl<VertexT>(g.graph(), g.to_new(source), g.to_new(sink), scratch);
+}
+
+std::int64_t FindingMaxFlow::findMaxFlow(const CsrGraph& g, int source, int sink) 
+{
+    return findMaxFlowImpl<int>(g, source, sink, scratch);
+}
+
+std::int64_t FindingMaxFlow::findMaxFlow(const CompressedGraph& g, int source, int sink) 
+{
+    return findMaxFlowImpl<int>(g, source, sink, scratch);
+}
+
+#define INSTANTIATE_MAX_FLOW(VertexT, WeightT) \
+    template std::int64_t FindingMaxFlow::findMaxFlow<VertexT, WeightT>(const BasicGraph<VertexT, WeightT>&, VertexT, VertexT); \
+    template std::int64_t FindingMaxFlow::findMaxFlow<VertexT, WeightT>(const ReorderedGraph<VertexT, WeightT>&, VertexT, VertexT);
+GRAPH_FOR_EACH_TYPE(INSTANTIATE_MAX_FLOW)
+#undef INSTANTIATE_MAX_FLOW
@@ -13,12 +13,46 @@ and augments the flow along that path until no more augmenting paths can be foun
 #pragma once
 
 #include "../part_1/graph_impl.hpp"
+#include "../part_1/csr_graph.hpp"
+#include "../part_1/graph_reorder.hpp"
+#include "../part_1/compressed_graph.hpp"
 #include <queue>
 #include <vector>
-#include <climits>
+#include <memory_resource>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
 
 class FindingMaxFlow 
 {
 public:
-    int findMaxFlow(Graph& g, int source, int sink);
+    // Scratch memory (residual network and BFS state) comes from scratch, e.g. a per-request arena
+    explicit FindingMaxFlow(std::pmr::memory_resource* scratch = std::pmr::get_default_resource()) : scratch(scratch) {}
+
+    /*
+    The graph is only read: residual capacities live in scratch arrays owned by the call.
+    Works for every BasicGraph vertex/weight type (see GRAPH_FOR_EACH_TYPE); the flow is summed in 64 bits.
+    Parallel u->v edges count once, with the last capacity (the one get_capacity(u, v) returns), not summed;
+    merge them with DuplicateEdgePolicy::SumCapacities first to add them up.
+    Throws std::out_of_range if source or sink is not a vertex.
+    */
+    template <typename VertexT, typename WeightT>
+    std::int64_t findMaxFlow(const BasicGraph<VertexT, WeightT>& g,
+                             typename BasicGraph<VertexT, WeightT>::VertexId source,
+                             typename BasicGraph<VertexT, WeightT>::VertexId sink);
+
+    // Same algorithm on a relabeled graph (source/sink are original ids)
+    template <typename VertexT, typename WeightT>
+    std::int64_t findMaxFlow(const ReorderedGraph<VertexT, WeightT>& g,
+                             typename BasicGraph<VertexT, WeightT>::VertexId source,
+                             typename BasicGraph<VertexT, WeightT>::VertexId sink);
+
+    // Same algorithm on the contiguous CSR representation
+    std::int64_t findMaxFlow(const CsrGraph& g, int source, int sink);
+
+    // Same algorithm on compressed adjacency (lists are decoded once, while the residual network is built)
+    std::int64_t findMaxFlow(const CompressedGraph& g, int source, int sink);
+
+private:
+    std::pmr::memory_resource* scratch;
 };
\ No newline at end of file
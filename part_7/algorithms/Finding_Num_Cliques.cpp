@@ -1,8 +1,13 @@
 #include "Finding_Num_Cliques.hpp"
 
+#include <climits>
+
 
 // Helper function to check if a set of vertices forms a clique
-static bool isClique(const Graph& graph, const std::vector<int>& vertices) 
+// (every pair lookup goes through the edge index: O(1) bit test or a binary search, not a list scan)
+// Edges is EdgeIndex or CompressedEdges, anything with contains(u, v).
+template <typename Edges>
+static bool isClique(const Edges& edges, const std::pmr::vector<int>& vertices) 
 {
 	for (size_t i = 0; i < vertices.size(); ++i) 
     {
@@ -10,7 +15,7 @@ static bool isClique(const Graph& graph, const std::vector<int>& vertices)
         {	
 
 			// Check if there's an edge between vertices[i] and vertices[j]:
-			if (!graph.is_edge(vertices[i], vertices[j])) 
+			if (!edges.contains(vertices[i], vertices[j])) 
             {
 				return false; // If any pair is not connected, it's not a clique
 			}
@@ -30,30 +35,84 @@ recursing to build larger combinations.
 *The sum of all recursive calls gives the total number of k-cliques.
 */
 
-static int countCliquesRecursive(const Graph& graph, int k, int start, std::vector<int>& current) 
+template <typename Edges>
+static int countCliquesRecursive(const Edges& edges, int n, int k, int start, std::pmr::vector<int>& current) 
 {	
 
 	// Base case: if current combination has k vertices:
 	if (static_cast<int>(current.size()) == k) 
     {
-		return isClique(graph, current) ? 1 : 0;
+		return isClique(edges, current) ? 1 : 0;
 	}
 	int count = 0;
-	int n = graph.get_vertices();
 	for (int v = start; v < n; ++v) 
     {
 		current.push_back(v);
-		count += countCliquesRecursive(graph, k, v + 1, current); //Calling itself recursively to build combinations.
+		count += countCliquesRecursive(edges, n, k, v + 1, current); //Calling itself recursively to build combinations.
 		current.pop_back(); // Backtrack: remove last vertex added
 	}
 	return count;
 }
 
 // Count cliques of size k
-int FindingNumCliques::countCliques(const Graph& graph, int k) 
+// Uses the graph's own edge index when it was built, otherwise builds a temporary one (O(V+E), once per call).
+// (the index, and so this algorithm, addresses vertices with int)
+template <typename VertexT, typename WeightT>
+int FindingNumCliques::countCliques(const BasicGraph<VertexT, WeightT>& graph, int k) 
 {
-	std::vector<int> current; // creates an empty vector current to hold the current combination of vertices.
-	return countCliquesRecursive(graph, k, 0, current); // Recursively builds all possible groups of k vertices and counts those that form cliques.
+	if (static_cast<std::uint64_t>(graph.get_vertices()) > static_cast<std::uint64_t>(INT_MAX)) 
+    {
+		throw std::length_error("clique counting supports at most INT_MAX vertices");
+	}
+	const int n = static_cast<int>(graph.get_vertices());
+	EdgeIndex local;
+	if (!graph.has_edge_index()) 
+    {
+		local = EdgeIndex(n, graph.getAdjList());
+	}
+	const EdgeIndex& edges = graph.has_edge_index() ? graph.get_edge_index() : local;
+
+	std::pmr::vector<int> current(scratch); // creates an empty vector current to hold the current combination of vertices.
+	current.reserve(k > 0 ? k : 0); // reused by every combination, it never holds more than k vertices
+	return countCliquesRecursive(edges, n, k, 0, current); // Recursively builds all possible groups of k vertices and counts those that form cliques.
     // The result is the total number of k-cliques in the graph.
 }
 
+template <typename VertexT, typename WeightT>
+int FindingNumCliques::countCliques(const ReorderedGraph<VertexT, WeightT>& graph, int k) 
+{
+	return countCliques(graph.graph(), k);
+}
+
+// Same algorithm on the contiguous CSR representation
+int FindingNumCliques::countCliques(const CsrGraph& graph, int k) 
+{
+	EdgeIndex edges(graph.get_vertices(), graph.get_offsets().data(), graph.get_targets().data());
+	std::pmr::vector<int> current(scratch);
+	current.reserve(k > 0 ? k : 0);
+	return countCliquesRecursive(edges, graph.get_vertices(), k, 0, current);
+}
+
+/*
+Compressed lists are sorted by target, so is_edge stops decoding as soon as it passes v.
+No index is built: the point of the compressed graph is not to hold an O(E) uncompressed copy.
+*/
+struct CompressedEdges
+{
+	const CompressedGraph& graph;
+	bool contains(int u, int v) const { return graph.is_edge(u, v); }
+};
+
+int FindingNumCliques::countCliques(const CompressedGraph& graph, int k) 
+{
+	CompressedEdges edges{graph};
+	std::pmr::vector<int> current(scratch);
+	current.reserve(k > 0 ? k : 0);
+	return countCliquesRecursive(edges, graph.get_vertices(), k, 0, current);
+}
+
+#define INSTANTIATE_CLIQUES(VertexT, WeightT) \
+	template int FindingNumCliques::countCliques<VertexT, WeightT>(const BasicGraph<VertexT, WeightT>&, int); \
+	template int FindingNumCliques::countCliques<VertexT, WeightT>(const ReorderedGraph<VertexT, WeightT>&, int);
+GRAPH_FOR_EACH_TYPE(INSTANTIATE_CLIQUES)
+#undef INSTANTIATE_CLIQUES
@@ -11,13 +11,34 @@ a method to count the number of cliques of a given size in a graph.
 #pragma once
 
 #include "../part_1/graph_impl.hpp"
+#include "../part_1/csr_graph.hpp"
+#include "../part_1/graph_reorder.hpp"
+#include "../part_1/compressed_graph.hpp"
 
 #include <vector>
+#include <memory_resource>
 #include <algorithm>
 
 class FindingNumCliques 
 {
 public:
-    // Counts the number of cliques of size k in the given graph
-    int countCliques(const Graph& graph, int k);
+    // Scratch memory (the vertex combination being tested) comes from scratch, e.g. a per-request arena
+    explicit FindingNumCliques(std::pmr::memory_resource* scratch = std::pmr::get_default_resource()) : scratch(scratch) {}
+
+    // Counts the number of cliques of size k in the given graph (for every BasicGraph vertex/weight type)
+    template <typename VertexT, typename WeightT>
+    int countCliques(const BasicGraph<VertexT, WeightT>& graph, int k);
+
+    // Same algorithm on a relabeled graph (the count does not depend on the numbering)
+    template <typename VertexT, typename WeightT>
+    int countCliques(const ReorderedGraph<VertexT, WeightT>& graph, int k);
+
+    // Same algorithm on the contiguous CSR representation
+    int countCliques(const CsrGraph& graph, int k);
+
+    // Same algorithm on compressed adjacency (pair lookups decode the sorted lists)
+    int countCliques(const CompressedGraph& graph, int k);
+
+private:
+    std::pmr::memory_resource* scratch;
 };
\ No newline at end of file
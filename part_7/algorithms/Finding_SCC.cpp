@@ -12,12 +12,13 @@ It records the finishing order of vertices for Kosaraju's algorithm.
 Vertices are pushed onto the stack after all their descendants are visited,
 so the stack ends up with vertices ordered by their finishing times (used to find SCCs in the transposed graph).
 */
-static void dfsFillOrder(const Graph& graph, int v, std::vector<bool>& visited, std::stack<int>& order) 
+template <typename VertexT, typename G>
+static void dfsFillOrder(const G& graph, VertexT v, std::pmr::vector<bool>& visited, std::stack<VertexT, std::pmr::deque<VertexT>>& order) 
 {
 	visited[v] = true; // Mark the current node as visited
 
 	// Recur for all the vertices adjacent to this vertex(v):
-	for (int u : graph.get_neighbors(v)) 
+	for (VertexT u : graph.get_neighbors(v)) 
     {
 		if (!visited[u]) 
         {
@@ -27,6 +28,19 @@ static void dfsFillOrder(const Graph& graph, int v, std::vector<bool>& visited,
 	order.push(v); // Push v to stack after visiting all its neighbors
 }
 
+/*
+The transposed graph (G^t) in CSR form, using the vertex type of the input graph:
+the arcs entering v in the original graph are target[offset[v] .. offset[v+1]).
+*/
+template <typename VertexT>
+struct Transpose
+{
+	std::pmr::vector<std::size_t> offset;
+	std::pmr::vector<VertexT> target;
+
+	explicit Transpose(std::pmr::memory_resource* scratch) : offset(scratch), target(scratch) {}
+};
+
 /*
 This function performs a depth-first search (DFS) on the transposed graph (G^t) , starting from vertex v:
 *It marks v as visited.
@@ -38,12 +52,14 @@ It collects all vertices reachable from v in the transposed graph,
 forming one strongly connected component (SCC).
 Each call finds and records a complete SCC.
 */
-static void dfsOnTranspose(const std::vector<std::vector<int>>& transpose, int v, std::vector<bool>& visited, std::vector<int>& component) \
+template <typename VertexT>
+static void dfsOnTranspose(const Transpose<VertexT>& transpose, VertexT v, std::pmr::vector<bool>& visited, std::vector<VertexT>& component)
 {
 	visited[v] = true;
 	component.push_back(v);
-	for (int u : transpose[v]) 
+	for (std::size_t a = transpose.offset[v]; a < transpose.offset[v + 1]; ++a) 
     {
+		VertexT u = transpose.target[a];
 		if (!visited[u]) 
         {
 			dfsOnTranspose(transpose, u, visited, component); // Recursive call
@@ -51,6 +67,41 @@ static void dfsOnTranspose(const std::vector<std::vector<int>>& transpose, int v
 	}
 }
 
+/*
+Builds the transpose in two passes (count in-degrees + prefix sum, then scatter):
+every arc v->u of the graph becomes an arc u->v of the transpose.
+The transpose is one contiguous block instead of n separately allocated vectors (from the scratch resource),
+and no intermediate edge list is needed.
+*/
+template <typename VertexT, typename G>
+static Transpose<VertexT> buildTranspose(const G& graph, std::pmr::memory_resource* scratch)
+{
+	const VertexT n = static_cast<VertexT>(graph.get_vertices());
+	Transpose<VertexT> t(scratch);
+	t.offset.assign(static_cast<std::size_t>(n) + 1, 0);
+	for (VertexT v = 0; v < n; ++v) 
+    {
+		for (VertexT u : graph.get_neighbors(v)) 
+        {
+			++t.offset[u + 1];
+		}
+	}
+	for (VertexT v = 0; v < n; ++v) 
+    {
+		t.offset[v + 1] += t.offset[v];
+	}
+	t.target.resize(t.offset[n]);
+	std::pmr::vector<std::size_t> cursor(t.offset.begin(), t.offset.end() - 1, scratch);
+	for (VertexT v = 0; v < n; ++v) 
+    {
+		for (VertexT u : graph.get_neighbors(v)) 
+        {
+			t.target[cursor[u]++] = v;
+		}
+	}
+	return t;
+}
+
 /*
 This function, FindingSCC::findSCCs, implements Kosaraju's algorithm to find all strongly connected components (SCCs) in a directed graph:
 1. Perform a DFS on the original graph to determine the finishing order of vertices (dfsFillOrder).
@@ -59,14 +110,15 @@ This function, FindingSCC::findSCCs, implements Kosaraju's algorithm to find all
 
 *Each SCC is stored as a vector of vertex indices in the result. The function returns a list of all SCCs found in the graph.
 */
-std::vector<std::vector<int>> FindingSCC::findSCCs(const Graph& graph) 
+template <typename VertexT, typename G>
+static std::vector<std::vector<VertexT>> findSCCsImpl(const G& graph, std::pmr::memory_resource* scratch) 
 {
-	int n = graph.get_vertices();
-	std::vector<bool> visited(n, false);
-	std::stack<int> order;
+	const VertexT n = static_cast<VertexT>(graph.get_vertices());
+	std::pmr::vector<bool> visited(n, false, scratch);
+	std::stack<VertexT, std::pmr::deque<VertexT>> order{std::pmr::deque<VertexT>(scratch)};
 
 	// 1. Fill vertices in stack according to their finishing times
-	for (int v = 0; v < n; ++v) 
+	for (VertexT v = 0; v < n; ++v) 
     {
 		if (!visited[v]) 
         {
@@ -75,28 +127,133 @@ std::vector<std::vector<int>> FindingSCC::findSCCs(const Graph& graph)
 	}
 
 	// 2. Create transpose of the graph
-	std::vector<std::vector<int>> transpose(n);
-	const auto& adj = graph.getAdjList();
-	for (int v = 0; v < n; ++v) 
-    {
-		for (int u : adj[v]) 
-        {
-			transpose[u].push_back(v);
-		}
-	}
+	Transpose<VertexT> transpose = buildTranspose<VertexT>(graph, scratch);
 
 	// 3. Process all vertices in order defined by Stack
 	std::fill(visited.begin(), visited.end(), false);
-	std::vector<std::vector<int>> sccs;
+	std::vector<std::vector<VertexT>> sccs;
 	while (!order.empty()) 
     {
-		int v = order.top(); order.pop();
+		VertexT v = order.top(); order.pop();
 		if (!visited[v]) 
         {
-			std::vector<int> component; // To store current SCC
+			std::vector<VertexT> component; // To store current SCC
 			dfsOnTranspose(transpose, v, visited, component); // Get one SCC
 			sccs.push_back(component); // Add current SCC to the list of SCCs
 		} 
 	}
 	return sccs;
 }
+
+template <typename VertexT, typename WeightT>
+std::vector<std::vector<VertexT>> FindingSCC::findSCCs(const BasicGraph<VertexT, WeightT>& graph) 
+{
+	return findSCCsImpl<VertexT>(graph, scratch);
+}
+
+template <typename VertexT, typename WeightT>
+std::vector<std::vector<VertexT>> FindingSCC::findSCCs(const ReorderedGraph<VertexT, WeightT>& graph) 
+{
+	std::vector<std::vector<VertexT>> sccs = findSCCsImpl<VertexT>(graph.graph(), scratch);
+	for (auto& component : sccs) 
+    {
+		for (auto& v : component) 
+        {
+			v = graph.to_old(v); // back to the caller's numbering
+		}
+	}
+	return sccs;
+}
+
+std::vector<std::vector<int>> FindingSCC::findSCCs(const CsrGraph& graph) 
+{
+	return findSCCsImpl<int>(graph, scratch);
+}
+
+std::vector<std::vector<int>> FindingSCC::findSCCs(const CompressedGraph& graph) 
+{
+	return findSCCsImpl<int>(graph, scratch);
+}
+
+/*
+Kosaraju's algorithm on an implicit graph (graph too large to store), in O(V) memory:
+*Both DFS passes are iterative: a recursive DFS on a 10^7-vertex random graph goes millions of calls deep.
+The first pass keeps (vertex, next list slot) per stack entry, so a list is resumed, never stored.
+*The second pass walks the in-arcs the graph computes (inverse permutations) instead of building the transpose;
+a component is collected in any order, so a plain stack of vertices is enough there.
+*/
+std::vector<std::vector<int>> FindingSCC::findSCCs(const ImplicitGraph& graph) 
+{
+	struct Frame 
+	{
+		ImplicitGraph::VertexId v;
+		std::uint32_t slot;
+	};
+	const int n = graph.get_vertices();
+	const ImplicitGraph::Entries out = graph.list_entries();
+	const ImplicitGraph::Entries in = graph.is_directed() ? ImplicitGraph::Entries::In : ImplicitGraph::Entries::Both;
+	std::pmr::vector<bool> visited(n, false, scratch);
+	std::pmr::vector<ImplicitGraph::VertexId> order(scratch); // finishing order
+	order.reserve(n);
+	std::pmr::vector<Frame> frames(scratch);
+	ImplicitGraph::Arc arc{};
+
+	// 1. Finishing order
+	for (int s = 0; s < n; ++s) 
+	{
+		if (visited[s]) continue;
+		visited[s] = true;
+		frames.push_back({static_cast<ImplicitGraph::VertexId>(s), 0});
+		while (!frames.empty()) 
+		{
+			Frame& top = frames.back();
+			top.slot = graph.next_arc(top.v, top.slot, out, arc);
+			if (top.slot == ImplicitGraph::END) 
+			{
+				order.push_back(top.v); // all neighbors done
+				frames.pop_back();
+				continue;
+			}
+			++top.slot;
+			if (!visited[arc.target]) 
+			{
+				visited[arc.target] = true;
+				frames.push_back({arc.target, 0});
+			}
+		}
+	}
+
+	// 2. Components along the in-arcs, latest finish first
+	std::fill(visited.begin(), visited.end(), false);
+	std::pmr::vector<ImplicitGraph::VertexId> pending(scratch);
+	std::vector<std::vector<int>> sccs;
+	for (auto it = order.rbegin(); it != order.rend(); ++it) 
+	{
+		if (visited[*it]) continue;
+		std::vector<int> component;
+		visited[*it] = true;
+		pending.push_back(*it);
+		while (!pending.empty()) 
+		{
+			ImplicitGraph::VertexId v = pending.back();
+			pending.pop_back();
+			component.push_back(static_cast<int>(v));
+			for (std::uint32_t slot = graph.next_arc(v, 0, in, arc); slot != ImplicitGraph::END; slot = graph.next_arc(v, slot + 1, in, arc)) 
+			{
+				if (!visited[arc.target]) 
+				{
+					visited[arc.target] = true;
+					pending.push_back(arc.target);
+				}
+			}
+		}
+		sccs.push_back(std::move(component));
+	}
+	return sccs;
+}
+
+#define INSTANTIATE_SCC(VertexT, WeightT) \
+	template std::vector<std::vector<VertexT>> FindingSCC::findSCCs<VertexT, WeightT>(const BasicGraph<VertexT, WeightT>&); \
+	template std::vector<std::vector<VertexT>> FindingSCC::findSCCs<VertexT, WeightT>(const ReorderedGraph<VertexT, WeightT>&);
+GRAPH_FOR_EACH_TYPE(INSTANTIATE_SCC)
+#undef INSTANTIATE_SCC
@@ -10,13 +10,38 @@ the algorithm to find Strongly Connected Components (SCCs) in a directed graph u
 #pragma once
 
 #include "../part_1/graph_impl.hpp"
+#include "../part_1/csr_graph.hpp"
+#include "../part_1/graph_reorder.hpp"
+#include "../part_1/compressed_graph.hpp"
+#include "../part_1/implicit_graph.hpp"
 #include <vector>
+#include <memory_resource>
 #include <stack>
 #include <algorithm>
 
 class FindingSCC 
 {
 public:
-    // Returns a vector of SCCs, each SCC is a vector of vertex indices
-    std::vector<std::vector<int>> findSCCs(const Graph& graph);
+    // Scratch memory (visited flags, finishing order and the transpose) comes from scratch, e.g. a per-request arena
+    explicit FindingSCC(std::pmr::memory_resource* scratch = std::pmr::get_default_resource()) : scratch(scratch) {}
+
+    // Returns a vector of SCCs, each SCC is a vector of vertex indices (for every BasicGraph vertex/weight type)
+    template <typename VertexT, typename WeightT>
+    std::vector<std::vector<VertexT>> findSCCs(const BasicGraph<VertexT, WeightT>& graph);
+
+    // Same algorithm on a relabeled graph, the components are returned with the original vertex ids
+    template <typename VertexT, typename WeightT>
+    std::vector<std::vector<VertexT>> findSCCs(const ReorderedGraph<VertexT, WeightT>& graph);
+
+    // Same algorithm on the contiguous CSR representation
+    std::vector<std::vector<int>> findSCCs(const CsrGraph& graph);
+
+    // Same algorithm on compressed adjacency (the transpose is built uncompressed, it only lives during the call)
+    std::vector<std::vector<int>> findSCCs(const CompressedGraph& graph);
+
+    // Same algorithm on an implicit graph in O(V) memory: iterative, no transpose (walks the computed in-arcs)
+    std::vector<std::vector<int>> findSCCs(const ImplicitGraph& graph);
+
+private:
+    std::pmr::memory_resource* scratch;
 };
\ No newline at end of file
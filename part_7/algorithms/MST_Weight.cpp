@@ -1,4 +1,5 @@
 #include "MST_Weight.hpp"
+#include <utility>
 
 /*
 This code defines the Edge struct and its comparison operator:
@@ -9,9 +10,11 @@ Purpose:
 Sorting edges by weight is essential for Kruskal's algorithm,
 which builds the minimum spanning tree (MST) by repeatedly adding the smallest-weight edge that doesn't form a cycle.
 */
+template <typename VertexT, typename WeightT>
 struct Edge 
 {
-	int u, v, weight;
+	VertexT u, v;
+	WeightT weight;
 	
 	// Compare edges by weight:
 	bool operator<(const Edge& other) const 
@@ -31,19 +34,21 @@ Purpose:
 DSU is used in Kruskal's algorithm to efficiently check whether adding an edge would form a cycle.
 It keeps track of connected components as edges are added to the MST.
 */
+template <typename VertexT>
 class DSU 
 {
-	std::vector<int> parent, rank;
+	std::pmr::vector<VertexT> parent;
+	std::pmr::vector<int> rank;
 public:
 
-	// Constructor:
-	DSU(int n) : parent(n), rank(n, 0) 
+	// Constructor (both arrays come from the scratch resource):
+	DSU(VertexT n, std::pmr::memory_resource* scratch) : parent(n, scratch), rank(n, 0, scratch) 
     {
-		for (int i = 0; i < n; ++i) parent[i] = i;
+		for (VertexT i = 0; i < n; ++i) parent[i] = i;
 	}
 
 	//Find  the representative of the set containing x:
-	int find(int x) 
+	VertexT find(VertexT x) 
     {
 		if (parent[x] != x){
 			parent[x] = find(parent[x]); // Path compression(recursive call)
@@ -53,10 +58,10 @@ public:
 	}
 
 	// Unite the sets containing x and y:
-	bool unite(int x, int y) 
+	bool unite(VertexT x, VertexT y) 
     {
-		int xr = find(x);
-		int yr = find(y);
+		VertexT xr = find(x);
+		VertexT yr = find(y);
 
 		// If they are already in the same set, return false:
 		if (xr == yr){ 
@@ -88,29 +93,30 @@ This function implements Kruskal's algorithm to find the total weight of the Min
 *Uses the DSU (Union-Find) structure to add edges one by one, only if they connect different components (to avoid cycles).
 *Adds the edge's weight to the total MST weight.
 *Stops when enough edges have been added to connect all vertices (n - 1 edges for n vertices).
-*Returns the total MST weight.
+*Returns the total MST weight (64-bit, so large weighted graphs do not overflow).
 */
-int MSTWeight::findMSTWeight(const Graph& graph) 
+template <typename VertexT, typename WeightT, typename G>
+static std::int64_t findMSTWeightImpl(const G& graph, std::pmr::memory_resource* scratch) 
 {
-	int n = graph.get_vertices();
-	std::vector<Edge> edges; // To store all edges
-	const auto& adj = graph.getAdjList();
-	const auto& capacity = graph.get_capacity();
-	for (int u = 0; u < n; ++u) 
+	const VertexT n = static_cast<VertexT>(graph.get_vertices());
+	std::pmr::vector<Edge<VertexT, WeightT>> edges(scratch); // To store all edges
+	edges.reserve(graph.get_edges()); // one block: regrowing on the monotonic scratch arena would keep every old buffer
+	for (VertexT u = 0; u < n; ++u) 
     {
-		for (int v : adj[u]) 
+		graph.for_each_arc(u, [&](auto target, auto weight) 
         {
+			VertexT v = static_cast<VertexT>(target);
 			if (u < v) { // Avoid duplicate edges in undirected graph
-				edges.push_back({u, v, capacity[u][v]});
+				edges.push_back({u, v, static_cast<WeightT>(weight)});
 			}
-		}
+		});
 	}
 
 	// Sort edges by weight:
 	std::sort(edges.begin(), edges.end());
-	DSU dsu(n); // Disjoint Set Union for cycle detection
-	int mst_weight = 0;
-	int edges_used = 0;
+	DSU<VertexT> dsu(n, scratch); // Disjoint Set Union for cycle detection
+	std::int64_t mst_weight = 0;
+	std::size_t edges_used = 0;
 
 	for (const auto& e : edges) 
     {	
@@ -121,10 +127,152 @@ int MSTWeight::findMSTWeight(const Graph& graph)
 			edges_used++; // Count edges used
 
 			// If we have n-1 edges, MST is complete:
-			if (edges_used == n - 1){ 
+			if (edges_used == static_cast<std::size_t>(n) - 1){ 
 				break;
 			}
 		}
 	}
 	return mst_weight;
-}
\ No newline at end of file
+}
+
+template <typename VertexT, typename WeightT>
+std::int64_t MSTWeight::findMSTWeight(const BasicGraph<VertexT, WeightT>& graph) 
+{
+	return findMSTWeightImpl<VertexT, WeightT>(graph, scratch);
+}
+
+template <typename VertexT, typename WeightT>
+std::int64_t MSTWeight::findMSTWeight(const ReorderedGraph<VertexT, WeightT>& graph) 
+{
+	return findMSTWeightImpl<VertexT, WeightT>(graph.graph(), scratch);
+}
+
+std::int64_t MSTWeight::findMSTWeight(const CsrGraph& graph) 
+{
+	return findMSTWeightImpl<int, int>(graph, scratch);
+}
+
+std::int64_t MSTWeight::findMSTWeight(const CompressedGraph& graph) 
+{
+	return findMSTWeightImpl<int, int>(graph, scratch);
+}
+
+/*
+This code defines VertexHeap, a binary min-heap of vertices keyed by weight that also stores the position of
+every vertex, so the key of a queued vertex is lowered in place:
+*push_or_lower(v, key): queues v, or lowers its key if the new one is smaller.
+*pop(): removes the vertex with the smallest key.
+Purpose:
+Prim's algorithm with at most one heap entry per vertex (three arrays of V entries), where a plain
+std::priority_queue would hold one entry per improving arc.
+*/
+class VertexHeap 
+{
+	std::pmr::vector<int> heap;
+	std::pmr::vector<int> pos; // index in heap, -1 when not queued
+	std::pmr::vector<int> key;
+
+	void swapAt(std::size_t i, std::size_t j) 
+	{
+		std::swap(heap[i], heap[j]);
+		pos[heap[i]] = static_cast<int>(i);
+		pos[heap[j]] = static_cast<int>(j);
+	}
+
+	void up(std::size_t i) 
+	{
+		while (i > 0 && key[heap[(i - 1) / 2]] > key[heap[i]]) 
+		{
+			swapAt(i, (i - 1) / 2);
+			i = (i - 1) / 2;
+		}
+	}
+
+	void down(std::size_t i) 
+	{
+		for (;;) 
+		{
+			std::size_t smallest = i, l = 2 * i + 1, r = l + 1;
+			if (l < heap.size() && key[heap[l]] < key[heap[smallest]]) smallest = l;
+			if (r < heap.size() && key[heap[r]] < key[heap[smallest]]) smallest = r;
+			if (smallest == i) return;
+			swapAt(i, smallest);
+			i = smallest;
+		}
+	}
+
+public:
+	VertexHeap(int n, std::pmr::memory_resource* scratch) : heap(scratch), pos(n, -1, scratch), key(n, 0, scratch) 
+	{
+		heap.reserve(n); // a vertex is queued at most once, so the heap never regrows
+	}
+
+	bool empty() const { return heap.empty(); }
+
+	void push_or_lower(int v, int k) 
+	{
+		if (pos[v] < 0) 
+		{
+			pos[v] = static_cast<int>(heap.size());
+			heap.push_back(v);
+			key[v] = k;
+			up(heap.size() - 1);
+		}
+		else if (k < key[v]) 
+		{
+			key[v] = k;
+			up(static_cast<std::size_t>(pos[v]));
+		}
+	}
+
+	// Removes the vertex with the smallest key: returns it and its key
+	std::pair<int, int> pop() 
+	{
+		const int top = heap[0];
+		swapAt(0, heap.size() - 1);
+		heap.pop_back();
+		pos[top] = -1;
+		if (!heap.empty()) down(0);
+		return {top, key[top]};
+	}
+};
+
+/*
+Prim's algorithm on an implicit graph, which has no edge list to sort (Kruskal would store all E edges):
+*Grows a tree from every vertex not reached yet (a minimum spanning forest, like Kruskal on a disconnected graph).
+*Every vertex's arcs are computed once, when the vertex joins the tree, so the whole graph is scanned in one pass.
+*O(V) memory: the in-tree flags and the VertexHeap.
+*/
+std::int64_t MSTWeight::findMSTWeight(const ImplicitGraph& graph) 
+{
+	const int n = graph.get_vertices();
+	std::pmr::vector<bool> inTree(n, false, scratch);
+	VertexHeap heap(n, scratch);
+	std::int64_t mst_weight = 0;
+	auto join = [&](int v) 
+	{
+		inTree[v] = true;
+		graph.for_each_arc(v, [&](ImplicitGraph::VertexId target, int weight) 
+		{
+			if (!inTree[target]) heap.push_or_lower(static_cast<int>(target), weight);
+		});
+	};
+	for (int root = 0; root < n; ++root) 
+	{
+		if (inTree[root]) continue;
+		join(root);
+		while (!heap.empty()) 
+		{
+			auto [v, weight] = heap.pop();
+			mst_weight += weight; // lightest edge from the tree to v
+			join(v);
+		}
+	}
+	return mst_weight;
+}
+
+#define INSTANTIATE_MST(VertexT, WeightT) \
+	template std::int64_t MSTWeight::findMSTWeight<VertexT, WeightT>(const BasicGraph<VertexT, WeightT>&); \
+	template std::int64_t MSTWeight::findMSTWeight<VertexT, WeightT>(const ReorderedGraph<VertexT, WeightT>&);
+GRAPH_FOR_EACH_TYPE(INSTANTIATE_MST)
+#undef INSTANTIATE_MST
@@ -15,13 +15,39 @@ Using also the DSU (Disjoint Set Union) data structure to efficiently manage and
 #pragma once
 
 #include "../part_1/graph_impl.hpp"
+#include "../part_1/csr_graph.hpp"
+#include "../part_1/graph_reorder.hpp"
+#include "../part_1/compressed_graph.hpp"
+#include "../part_1/implicit_graph.hpp"
 
 #include <vector>
+#include <memory_resource>
 #include <algorithm>
+#include <cstdint>
 
 class MSTWeight 
 {
 public:
-    // Returns the total weight of the MST
-    int findMSTWeight(const Graph& graph);
+    // Scratch memory (edge list and DSU arrays) comes from scratch, e.g. a per-request arena
+    explicit MSTWeight(std::pmr::memory_resource* scratch = std::pmr::get_default_resource()) : scratch(scratch) {}
+
+    // Returns the total weight of the MST (summed in 64 bits, for every BasicGraph vertex/weight type)
+    template <typename VertexT, typename WeightT>
+    std::int64_t findMSTWeight(const BasicGraph<VertexT, WeightT>& graph);
+
+    // Same algorithm on a relabeled graph (the weight does not depend on the numbering)
+    template <typename VertexT, typename WeightT>
+    std::int64_t findMSTWeight(const ReorderedGraph<VertexT, WeightT>& graph);
+
+    // Same algorithm on the contiguous CSR representation
+    std::int64_t findMSTWeight(const CsrGraph& graph);
+
+    // Same algorithm on compressed adjacency
+    std::int64_t findMSTWeight(const CompressedGraph& graph);
+
+    // Minimum spanning forest of an implicit graph in O(V) memory (Prim with an indexed heap instead of a sorted edge list)
+    std::int64_t findMSTWeight(const ImplicitGraph& graph);
+
+private:
+    std::pmr::memory_resource* scratch;
 };
@@ -27,9 +27,11 @@ int main()
 
     // Run max flow from source (0) to sink (5)
     FindingMaxFlow algo;
-    int maxFlow = algo.findMaxFlow(g_directed_1, 0, 5);
+    std::int64_t maxFlow = algo.findMaxFlow(g_directed_1, 0, 5);
 
     std::cout << "Max flow from 0 to 5: " << maxFlow << std::endl;
+    std::cout << "Max flow from 0 to 5 (CSR): " << algo.findMaxFlow(CsrGraph(g_directed_1), 0, 5) << std::endl;
+    std::cout << "Max flow from 0 to 5 (compressed): " << algo.findMaxFlow(CompressedGraph(g_directed_1), 0, 5) << std::endl;
     std::cout <<"---------------------------------------------------------------------------------------------------"<< std::endl;
     std::cout << "***************************************************************************************************" << std::endl;
     
@@ -60,6 +62,8 @@ int main()
     FindingSCC sccFinder;
     auto sccs = sccFinder.findSCCs(g_directed_2);
     std::cout << "Number of strongly connected components: " << sccs.size() << std::endl;
+    std::cout << "Number of strongly connected components (CSR): " << sccFinder.findSCCs(CsrGraph(g_directed_2)).size() << std::endl;
+    std::cout << "Number of strongly connected components (compressed): " << sccFinder.findSCCs(CompressedGraph(g_directed_2)).size() << std::endl;
     for (const auto& component : sccs) 
     {
         std::cout << "SCC: ";
@@ -70,6 +74,18 @@ int main()
         std::cout << std::endl;
     }
 
+    // Same graph relabeled for locality (RCM); the components come back with the original vertex ids
+    ReorderedGraph<int, int> g_directed_2_rcm(g_directed_2, VertexOrdering::RCM);
+    for (const auto& component : sccFinder.findSCCs(g_directed_2_rcm)) 
+    {
+        std::cout << "SCC (RCM order): ";
+        for (int v : component) 
+        {
+            std::cout << v << " ";
+        }
+        std::cout << std::endl;
+    }
+
     std::cout << "***************************************************************************************************" << std::endl;
 
     Graph g_undirected_1(6, false);
@@ -99,6 +115,8 @@ int main()
     int numCliques = cliqueFinder.countCliques(g_undirected_1, k);
     std::cout << "k = " << k << std::endl;
     std::cout << "Number of " << k << "-cliques: " << numCliques << std::endl;
+    std::cout << "Number of " << k << "-cliques (CSR): " << cliqueFinder.countCliques(CsrGraph(g_undirected_1), k) << std::endl;
+    std::cout << "Number of " << k << "-cliques (compressed): " << cliqueFinder.countCliques(CompressedGraph(g_undirected_1), k) << std::endl;
     std::cout <<"---------------------------------------------------------------------------------------------------"<< std::endl;
 
     std::cout << "***************************************************************************************************" << std::endl;
@@ -131,8 +149,37 @@ int main()
     // --- MST Weight ---
     std::cout << "\n--- Finding Minimum Spanning Tree (MST) Weight ---\n";
     MSTWeight mstFinder;
-    int mstWeight = mstFinder.findMSTWeight(g_undirected_2);
+    std::int64_t mstWeight = mstFinder.findMSTWeight(g_undirected_2);
     std::cout << "MST weight: " << mstWeight << std::endl;
+    std::cout << "MST weight (CSR): " << mstFinder.findMSTWeight(CsrGraph(g_undirected_2)) << std::endl;
+    std::cout << "MST weight (compressed): " << mstFinder.findMSTWeight(CompressedGraph(g_undirected_2)) << std::endl;
+
+    // --- Other vertex/weight types ---
+    // 64-bit weights: the totals no longer fit in int
+    BasicGraph<std::uint32_t, std::int64_t> g_heavy(3, false);
+    g_heavy.addEdge(0, 1, 3000000000LL);
+    g_heavy.addEdge(1, 2, 4000000000LL);
+    g_heavy.addEdge(0, 2, 5000000000LL);
+    std::cout << "MST weight (64-bit weights): " << mstFinder.findMSTWeight(g_heavy) << std::endl;
+
+    BasicGraph<std::uint32_t, std::int64_t> g_heavy_flow(3, true);
+    g_heavy_flow.addEdge(0, 1, 3000000000LL);
+    g_heavy_flow.addEdge(0, 2, 2000000000LL);
+    g_heavy_flow.addEdge(1, 2, 2500000000LL);
+    std::cout << "Max flow from 0 to 2 (64-bit weights): " << algo.findMaxFlow(g_heavy_flow, 0, 2) << std::endl;
+
+    // 1-byte weights: a unit-weight graph stores 1 byte per capacity instead of 4
+    BasicGraph<std::uint32_t, std::uint8_t> g_compact(7, true);
+    g_compact.addEdges({{0, 1}, {1, 2}, {2, 3}, {3, 0}, {1, 3}, {3, 4}, {2, 5}, {4, 5}, {5, 6}, {6, 4}});
+    std::cout << "Number of strongly connected components (1-byte weights): " << sccFinder.findSCCs(g_compact).size() << std::endl;
+
+    // --- Implicit graphs (lists computed from the seed, nothing stored) against the same edges in a Graph ---
+    ImplicitGraph g_implicit_directed(2000, 1800, 42, true);
+    ImplicitGraph g_implicit_undirected(2000, 6000, 42, false, 1, 100);
+    std::cout << "Number of strongly connected components (implicit / stored): " << sccFinder.findSCCs(g_implicit_directed).size()
+              << " / " << sccFinder.findSCCs(g_implicit_directed.to_graph()).size() << std::endl;
+    std::cout << "MST weight (implicit / stored): " << mstFinder.findMSTWeight(g_implicit_undirected)
+              << " / " << mstFinder.findMSTWeight(g_implicit_undirected.to_graph()) << std::endl;
 
     return 0;
 }
\ No newline at end of file
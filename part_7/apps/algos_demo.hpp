@@ -15,5 +15,7 @@ and calculating the weight of the minimum spanning tree (MST).
 #include "Finding_Num_Cliques.hpp"
 #include "Finding_SCC.hpp"
 #include "MST_Weight.hpp"
+#include "csr_graph.hpp"
+#include "graph_reorder.hpp"
 #include <iostream>
 #include "graph_impl.hpp"
@@ -0,0 +1,114 @@
+/*
+@author : Roy Meoded
+@author : Yarin Keshet
+
+@description: Benchmark for the edge-existence index used by the clique counter.
+1. Clique path: counts k-cliques with the old lookup (std::find over the neighbor list for every pair)
+   and with FindingNumCliques (edge index), and checks that both give the same count.
+2. Raw lookups: random is_edge(u, v) queries on a large sparse graph, linear scan vs. the index
+   (this graph is too big for a bit matrix, so the sorted-lists layout is measured).
+
+Usage: ./bench_cliques [V] [avg_degree] [k]
+*/
+
+#include "Finding_Num_Cliques.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+
+// The pre-index clique counter, kept here as the baseline
+static bool isCliqueScan(const Graph& graph, const std::vector<int>& vertices)
+{
+    for (size_t i = 0; i < vertices.size(); ++i)
+    {
+        for (size_t j = i + 1; j < vertices.size(); ++j)
+        {
+            const auto& nb = graph.get_neighbors(vertices[i]);
+            if (std::find(nb.begin(), nb.end(), vertices[j]) == nb.end())
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static long long countScan(const Graph& graph, int k, int start, std::vector<int>& current)
+{
+    if ((int)current.size() == k)
+    {
+        return isCliqueScan(graph, current) ? 1 : 0;
+    }
+    long long count = 0;
+    for (int v = start; v < graph.get_vertices(); ++v)
+    {
+        current.push_back(v);
+        count += countScan(graph, k, v + 1, current);
+        current.pop_back();
+    }
+    return count;
+}
+
+static Graph randomGraph(int V, long long E, unsigned seed)
+{
+    Graph g(V, false);
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> dist(0, V - 1);
+    for (long long i = 0; i < E; ++i)
+    {
+        int u = dist(rng), v = dist(rng);
+        if (u != v) g.addEdge(u, v);
+    }
+    return g;
+}
+
+template <typename F>
+static double timeMs(F f)
+{
+    auto t0 = std::chrono::steady_clock::now();
+    f();
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(t1 - t0).count();
+}
+
+int main(int argc, char* argv[])
+{
+    int V = argc > 1 ? std::atoi(argv[1]) : 80;
+    int deg = argc > 2 ? std::atoi(argv[2]) : 40;
+    int k = argc > 3 ? std::atoi(argv[3]) : 4;
+
+    // ---- 1) clique path ----
+    Graph g = randomGraph(V, 1LL * V * deg / 2, 42);
+    long long scanCount = 0, indexCount = 0;
+    double scanMs = timeMs([&] { std::vector<int> cur; scanCount = countScan(g, k, 0, cur); });
+    double indexMs = timeMs([&] { FindingNumCliques algo; indexCount = algo.countCliques(g, k); });
+    std::cout << "cliques V=" << V << " avg_degree=" << deg << " k=" << k << "\n";
+    std::cout << "  linear scan : " << scanMs << " ms (" << scanCount << " cliques)\n";
+    std::cout << "  edge index  : " << indexMs << " ms (" << indexCount << " cliques)\n";
+    std::cout << "  speedup     : " << (indexMs > 0 ? scanMs / indexMs : 0) << "x\n";
+    if (scanCount != indexCount)
+    {
+        std::cerr << "MISMATCH\n";
+        return 1;
+    }
+
+    // ---- 2) raw lookups on a large sparse graph ----
+    const int bigV = 200000;
+    Graph big = randomGraph(bigV, 2000000, 7);
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<int> dist(0, bigV - 1);
+    std::vector<std::pair<int, int>> queries(2000000);
+    for (auto& q : queries) q = {dist(rng), dist(rng)};
+
+    long long hitsScan = 0, hitsIndex = 0;
+    double lookupScanMs = timeMs([&] { for (auto& q : queries) hitsScan += big.is_edge(q.first, q.second); });
+    double buildMs = timeMs([&] { big.build_edge_index(); });
+    double lookupIndexMs = timeMs([&] { for (auto& q : queries) hitsIndex += big.is_edge(q.first, q.second); });
+    std::cout << "is_edge V=" << bigV << " E=" << big.get_edges() << " queries=" << queries.size()
+              << " (index mode: " << (big.get_edge_index().mode() == EdgeIndex::Mode::BIT_MATRIX ? "bit matrix" : "sorted lists") << ")\n";
+    std::cout << "  linear scan : " << lookupScanMs << " ms\n";
+    std::cout << "  edge index  : " << lookupIndexMs << " ms (+" << buildMs << " ms build)\n";
+    return hitsScan == hitsIndex ? 0 : 1;
+}
@@ -0,0 +1,111 @@
+/*
+@author : Roy Meoded
+@author : Yarin Keshet
+
+@description: Benchmark for implicit graphs (part_1/implicit_graph.hpp): algorithms on random graphs too large to
+store, with the neighbor lists computed from the seed on every visit.
+1. BFS from vertex 0 on the undirected graph (reached vertices, depth).
+2. MST weight of the undirected graph (Prim, one pass over the computed lists).
+3. SCC count of the directed graph with the same V and E (iterative Kosaraju over the computed in-arcs).
+Each step reports its time; the end reports the peak resident memory against the bytes a stored Graph of the
+same size would take. A small instance is then checked against the same edges stored in a Graph.
+
+Usage: ./bench_implicit [V] [edges_per_vertex] [seed]      (V = 10^7, 10 edges per vertex: a 10^8-edge graph)
+*/
+
+#include "Finding_SCC.hpp"
+#include "MST_Weight.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+template <typename F>
+static double measureMs(F f)
+{
+    auto t0 = std::chrono::steady_clock::now();
+    f();
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(t1 - t0).count();
+}
+
+// Peak resident set of this process in MiB (VmHWM), -1 when /proc is unavailable
+static long peakRssMiB()
+{
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line))
+    {
+        if (line.rfind("VmHWM:", 0) == 0)
+        {
+            return std::atol(line.c_str() + 6) / 1024;
+        }
+    }
+    return -1;
+}
+
+// Levels of a BFS from source: O(V) memory (distances + one frontier queue)
+static void bfs(const ImplicitGraph& g, int source, long long& reached, int& depth)
+{
+    std::vector<int> dist(g.get_vertices(), -1);
+    std::vector<ImplicitGraph::VertexId> queue;
+    queue.reserve(g.get_vertices());
+    dist[source] = 0;
+    queue.push_back(static_cast<ImplicitGraph::VertexId>(source));
+    depth = 0;
+    for (std::size_t head = 0; head < queue.size(); ++head)
+    {
+        const int u = static_cast<int>(queue[head]);
+        for (ImplicitGraph::VertexId v : g.get_neighbors(u))
+        {
+            if (dist[v] < 0)
+            {
+                dist[v] = dist[u] + 1;
+                depth = dist[v];
+                queue.push_back(v);
+            }
+        }
+    }
+    reached = static_cast<long long>(queue.size());
+}
+
+int main(int argc, char* argv[])
+{
+    const int V = argc > 1 ? std::atoi(argv[1]) : 10000000;
+    const std::uint64_t perVertex = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 10;
+    const std::uint64_t seed = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 1;
+    const std::uint64_t E = perVertex * static_cast<std::uint64_t>(V);
+
+    ImplicitGraph undirected(V, E, seed, false, 1, 1000);
+    ImplicitGraph directed(V, E, seed, true);
+    std::cout << "implicit graph: V=" << V << ", E=" << E << ", " << undirected.memory_bytes() << " bytes per graph\n";
+
+    long long reached = 0;
+    int depth = 0;
+    double ms = measureMs([&] { bfs(undirected, 0, reached, depth); });
+    std::cout << "  BFS from 0: " << reached << " vertices reached, depth " << depth << ", " << ms << " ms\n";
+
+    MSTWeight mst;
+    std::int64_t weight = 0;
+    ms = measureMs([&] { weight = mst.findMSTWeight(undirected); });
+    std::cout << "  MST weight: " << weight << ", " << ms << " ms\n";
+
+    FindingSCC scc;
+    std::size_t components = 0;
+    ms = measureMs([&] { components = scc.findSCCs(directed).size(); });
+    std::cout << "  SCC count (directed): " << components << ", " << ms << " ms\n";
+
+    const std::size_t stored = Graph::estimate_memory(V, static_cast<std::size_t>(E), false).total();
+    std::cout << "  peak RSS " << peakRssMiB() << " MiB (a stored undirected Graph would take "
+              << stored / (1024 * 1024) << " MiB)\n";
+
+    // Same results as the stored edges on a small instance
+    ImplicitGraph small(20000, 60000, seed, false, 1, 1000);
+    ImplicitGraph smallDirected(20000, 20000, seed, true);
+    bool ok = mst.findMSTWeight(small) == mst.findMSTWeight(small.to_graph()) &&
+              scc.findSCCs(smallDirected).size() == scc.findSCCs(smallDirected.to_graph()).size();
+    std::cout << "check against stored graph: " << (ok ? "same" : "MISMATCH") << "\n";
+    return ok ? 0 : 1;
+}
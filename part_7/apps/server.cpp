@@ -182,11 +182,7 @@ int run_server(int argc, char *argv[])
             int V = -1;
             int directed = 1; // default directed for MAX_FLOW
             int E = 0;
-            struct EdgeLine 
-            {
-                 int u, v, w; 
-            };
-            std::vector<EdgeLine> edges;
+            std::vector<GraphEdge> edges; // EDGE lines, added to the graph with one bulk call
             int src = -1, sink = -1; int k = -1;
 
             bool parse_error = false;
@@ -328,10 +324,7 @@ int run_server(int argc, char *argv[])
             try 
             {
                 Graph g(V, directed != 0);
-                for (const auto &e : edges)
-                {
-                    g.addEdge(e.u, e.v, e.w);
-                } 
+                g.addEdges(edges); // validates all edges first, then fills pre-sized lists
 
                 //Using the Factory to create the algorithm instance:
                 auto algoPtr = AlgorithmFactory::create(alg);
@@ -10,13 +10,13 @@ Steps:
 * If no match, returns nullptr
 */
 
-std::unique_ptr<IAlgorithm> AlgorithmFactory::create(const std::string& id) 
+std::unique_ptr<IAlgorithm> AlgorithmFactory::create(const std::string& id, std::pmr::memory_resource* scratch) 
 {
     std::string up = id;
     std::transform(up.begin(), up.end(), up.begin(), ::toupper); // Uppercases the whole id string in-place so matching is case-insensitive
-    if (up == "MAX_FLOW") return std::make_unique<MaxFlowAlgo>();
-    if (up == "CLIQUES") return std::make_unique<CliquesAlgo>();
-    if (up == "SCC") return std::make_unique<SCCAlgo>();
-    if (up == "MST") return std::make_unique<MSTAlgo>();
+    if (up == "MAX_FLOW") return std::make_unique<MaxFlowAlgo>(scratch);
+    if (up == "CLIQUES") return std::make_unique<CliquesAlgo>(scratch);
+    if (up == "SCC") return std::make_unique<SCCAlgo>(scratch);
+    if (up == "MST") return std::make_unique<MSTAlgo>(scratch);
     return nullptr;
 }
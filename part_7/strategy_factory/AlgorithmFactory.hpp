@@ -25,5 +25,6 @@ class AlgorithmFactory
 public:
 
     //Using unique_ptr for automatic memory management of created algorithm instances:
-    static std::unique_ptr<IAlgorithm> create(const std::string& id);
+    // scratch is handed to the algorithm (working arrays allocated from it, see IAlgorithm)
+    static std::unique_ptr<IAlgorithm> create(const std::string& id, std::pmr::memory_resource* scratch = std::pmr::get_default_resource());
 };
@@ -17,6 +17,7 @@ to find the number of cliques of size k in a given graph.
 class CliquesAlgo : public IAlgorithm 
 {
 public:
+    using IAlgorithm::IAlgorithm; // optional scratch memory resource
 
     // Returns the stable identifier for the algorithm:
     std::string id() const override
@@ -26,9 +27,23 @@ public:
 
     // Executes the algorithm on the given graph with parameters:
     std::string run(const Graph& g, const std::unordered_map<std::string,int>& params) override 
+    {
+        return runOn(g, params);
+    }
+
+    // Same, on a compressed graph:
+    std::string run(const CompressedGraph& g, const std::unordered_map<std::string,int>& params) override 
+    {
+        return runOn(g, params);
+    }
+
+private:
+    // One body for both graph representations
+    template <typename G>
+    std::string runOn(const G& g, const std::unordered_map<std::string,int>& params) const
     {
         int k = params.count("K") ? params.at("K") : 3; // Reads K from params (defaults to 3-because cliques of size >=2 are meaningful)
-        FindingNumCliques algo; // Instantiates the algorithm class
+        FindingNumCliques algo(scratch); // Instantiates the algorithm class (scratch memory from this strategy's resource)
         int res = algo.countCliques(g, k); // Executes the algorithm
         return "RESULT " + std::to_string(res); // Returns the result
     }
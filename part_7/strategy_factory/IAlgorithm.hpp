@@ -14,13 +14,18 @@ Each algorithm class will inherit from this interface-and each algorithm will pr
 
 #include <string>
 #include <unordered_map>
+#include <memory_resource>
 
 #include "../../part_1/graph_impl.hpp"
+#include "../../part_1/compressed_graph.hpp"
 
 // Strategy interface for algorithms:
 class IAlgorithm // Abstract base class (interface) for all algorithms
 {
 public:
+    // scratch: memory resource the algorithm allocates its working arrays from (e.g. a per-request arena)
+    explicit IAlgorithm(std::pmr::memory_resource* scratch = std::pmr::get_default_resource()) : scratch(scratch) {}
+
     virtual ~IAlgorithm() = default; // Virtual destructor
     virtual std::string id() const = 0; // Declares a pure virtual getter that returns a stable identifier for the algorithm,
     // without modifying the object
@@ -29,4 +34,10 @@ public:
     //In the unordered_map params-string keys represent parameter names(e.g., "SRC", "SINK", "K"), and int values represent their corresponding integer values:
     //Not  relevant for all algorithms(e.g., MST does not need parameters), but others do (e.g., MAX_FLOW needs SRC and SINK)
     virtual std::string run(const Graph& g, const std::unordered_map<std::string, int>& params) = 0; 
+
+    // Same, on a graph held in compressed adjacency form (same parameters, same result format):
+    virtual std::string run(const CompressedGraph& g, const std::unordered_map<std::string, int>& params) = 0;
+
+protected:
+    std::pmr::memory_resource* scratch;
 };
@@ -15,6 +15,7 @@ to find the weight of the Minimum Spanning Tree (MST) in a given graph.
 class MSTAlgo : public IAlgorithm 
 {
 public:
+    using IAlgorithm::IAlgorithm; // optional scratch memory resource
 
     // Returns the stable identifier for the algorithm:
     std::string id() const override 
@@ -25,8 +26,22 @@ public:
     //In MST algo, no parameters are needed, so we ignore the params map:
     std::string run(const Graph& g, const std::unordered_map<std::string,int>&) override 
     {
-        MSTWeight algo; // Instantiates the algorithm class
-        int res = algo.findMSTWeight(g); // Executes the algorithm
+        return runOn(g);
+    }
+
+    // Same, on a compressed graph:
+    std::string run(const CompressedGraph& g, const std::unordered_map<std::string,int>&) override 
+    {
+        return runOn(g);
+    }
+
+private:
+    // One body for both graph representations
+    template <typename G>
+    std::string runOn(const G& g) const
+    {
+        MSTWeight algo(scratch); // Instantiates the algorithm class (scratch memory from this strategy's resource)
+        std::int64_t res = algo.findMSTWeight(g); // Executes the algorithm (64-bit total)
         return "RESULT " + std::to_string(res); // Returns the result
     }
 };
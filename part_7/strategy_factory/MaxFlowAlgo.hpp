@@ -16,6 +16,7 @@ to find the maximum flow in a given graph using the Edmonds-Karp algorithm.
 class MaxFlowAlgo : public IAlgorithm 
 {
 public:
+    using IAlgorithm::IAlgorithm; // optional scratch memory resource
 
     // Returns the stable identifier for the algorithm:
     std::string id() const override
@@ -25,12 +26,25 @@ public:
 
     // Executes the algorithm on the given graph with parameters:
     std::string run(const Graph& g, const std::unordered_map<std::string,int>& params) override 
+    {
+        return runOn(g, params);
+    }
+
+    // Same, on a compressed graph:
+    std::string run(const CompressedGraph& g, const std::unordered_map<std::string,int>& params) override 
+    {
+        return runOn(g, params);
+    }
+
+private:
+    // One body for both graph representations
+    template <typename G>
+    std::string runOn(const G& g, const std::unordered_map<std::string,int>& params) const
     {
         int src = params.count("SRC") ? params.at("SRC") : 0; // Reads SRC from params (defaults to 0)
         int sink = params.count("SINK") ? params.at("SINK") : g.get_vertices()-1; // Reads SINK from params (defaults to last vertex)
-        FindingMaxFlow algo; // Instantiates the algorithm class
-        Graph gCopy = g; // make a modifiable copy for algorithms that mutate the graph
-        int res = algo.findMaxFlow(gCopy, src, sink); // Executes the algorithm
+        FindingMaxFlow algo(scratch); // Instantiates the algorithm class (scratch memory from this strategy's resource)
+        std::int64_t res = algo.findMaxFlow(g, src, sink); // Executes the algorithm (it keeps its residual capacities in its own arrays, the graph is not copied)
         return "RESULT " + std::to_string(res); // Returns the result
     }
 };
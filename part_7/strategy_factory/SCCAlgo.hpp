@@ -16,6 +16,7 @@ to find the strongly connected components (SCC) in a given graph.
 class SCCAlgo : public IAlgorithm 
 {
 public:
+    using IAlgorithm::IAlgorithm; // optional scratch memory resource
 
     // Returns the stable identifier for the algorithm:
     std::string id() const override 
@@ -26,7 +27,21 @@ public:
     //In SCC algo, no parameters are needed, so we ignore the params map:
     std::string run(const Graph& g, const std::unordered_map<std::string,int>&) override 
     {
-        FindingSCC algo; // Instantiates the algorithm class
+        return runOn(g);
+    }
+
+    // Same, on a compressed graph:
+    std::string run(const CompressedGraph& g, const std::unordered_map<std::string,int>&) override 
+    {
+        return runOn(g);
+    }
+
+private:
+    // One body for both graph representations
+    template <typename G>
+    std::string runOn(const G& g) const
+    {
+        FindingSCC algo(scratch); // Instantiates the algorithm class (scratch memory from this strategy's resource)
         auto sccs = algo.findSCCs(g); // Executes the algorithm
         return "RESULT " + std::to_string((int)sccs.size()); // Returns the result
     }
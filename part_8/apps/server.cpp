@@ -163,7 +163,8 @@ static string trim_cr(string s)
 }
 
 // Helper function for running an algorithm and handling errors
-static string run_alg_or_error(const string& alg, const Graph& g, const unordered_map<string,int>& params, bool requestedDirected)
+static string run_alg_or_error(const string& alg, const Graph& g, const unordered_map<string,int>& params, bool requestedDirected,
+                               std::pmr::memory_resource* scratch)
 {
     // directed-required algorithms
     bool isDirectedAlg = (alg=="MAX_FLOW" || alg=="SCC");
@@ -174,7 +175,7 @@ static string run_alg_or_error(const string& alg, const Graph& g, const unordere
         er << "Error: cannot run " << alg << " on " << (requestedDirected?"directed":"undirected") << " graph";
         return er.str();
     }
-    auto ptr = AlgorithmFactory::create(alg);
+    auto ptr = AlgorithmFactory::create(alg, scratch);
     if (!ptr)
     {
         return "Unsupported algorithm";
@@ -185,63 +186,216 @@ static string run_alg_or_error(const string& alg, const Graph& g, const unordere
 // Helper function for serializing graph edges
 static std::string serialize_graph_edges(const Graph& g, bool directed)
 {
-    const auto& cap = g.get_capacity();
-    std::ostringstream out;
+    /*
+    Walk the sparse edge storage instead of a VxV matrix:
+    *Collect (u, v, w) for every stored edge (for undirected graphs only u < v, each edge is stored twice).
+    *Sort by (u, v) so the output order is stable, and if the same pair was added more than once
+    keep the most recently added weight (stable sort keeps insertion order inside a run).
+    */
+    struct OutEdge
+    {
+        int u, v, w;
+    };
+    const auto& adj = g.getAdjList();
+    const auto& wts = g.getWeightList();
     int V = g.get_vertices();
-    int count = 0;
-    // First count edges for header
-    if (directed) 
+    std::vector<OutEdge> list;
+    list.reserve(g.get_edges());
+    for (int u=0; u<V; ++u)
     {
-        for (int u=0; u<V; ++u)
+        for (size_t i=0; i<adj[u].size(); ++i)
         {
-            for (int v=0; v<V; ++v)
+            int v = adj[u][i];
+            if (directed || u < v)
             {
-                if (cap[u][v] > 0)
-                {
-                    ++count;
-                }
+                list.push_back({u, v, wts[u][i]});
             }
-        } 
+        }
     }
-    else 
+    std::stable_sort(list.begin(), list.end(), [](const OutEdge& a, const OutEdge& b)
+    {
+        return a.u != b.u ? a.u < b.u : a.v < b.v;
+    });
+
+    std::vector<OutEdge> unique_edges;
+    unique_edges.reserve(list.size());
+    for (size_t i=0; i<list.size(); ++i)
     {
-        for (int u=0; u<V; ++u)
+        bool lastOfRun = (i+1 == list.size()) || list[i+1].u != list[i].u || list[i+1].v != list[i].v;
+        if (lastOfRun && list[i].w > 0)
         {
-            for (int v=u+1; v<V; ++v)
-            {
-                if (cap[u][v] > 0 || cap[v][u] > 0)
-                {
-                    ++count;
-                }
-            }
-        } 
+            unique_edges.push_back(list[i]);
+        }
+    }
+
+    std::ostringstream out;
+    out << "GRAPH " << V << " " << unique_edges.size() << "\n";
+    for (const auto& e : unique_edges)
+    {
+        out << "EDGE " << e.u << " " << e.v << " " << e.w << "\n";
     }
-    out << "GRAPH " << V << " " << count << "\n";
-    if (directed) 
+    return out.str();
+}
+
+// PREVIEW of a generated graph, written while the generator streams it (edge_sink.hpp): the stream is asked to
+// be sorted by (u, v) with every pair once, so the text is what serialize_graph_edges prints for the built graph.
+// The response is sent as one body, so the whole text is held until the generator is done.
+class PreviewWriter : public EdgeSink
+{
+public:
+    void begin(int vertices, bool, std::size_t edges) override
     {
-        for (int u=0; u<V; ++u)
+        text = "GRAPH " + std::to_string(vertices) + " " + std::to_string(edges) + "\n";
+    }
+
+    void consume(const GraphEdge* edges, std::size_t count) override
+    {
+        char line[48];
+        for (std::size_t i = 0; i < count; ++i)
         {
-           for (int v=0; v<V; ++v)
-           {
-               if (cap[u][v] > 0) out << "EDGE " << u << " " << v << " " << cap[u][v] << "\n";
-           }
-        } 
+            char* p = line + 5;
+            std::memcpy(line, "EDGE ", 5);
+            p = std::to_chars(p, line + sizeof(line), edges[i].u).ptr;
+            *p++ = ' ';
+            p = std::to_chars(p, line + sizeof(line), edges[i].v).ptr;
+            *p++ = ' ';
+            p = std::to_chars(p, line + sizeof(line), edges[i].w).ptr;
+            *p++ = '\n';
+            text.append(line, p);
+        }
     }
-    else 
+
+    bool needs_sorted() const override { return true; }
+
+    std::string text;
+};
+
+// Graph directory (argv[3]): FILE names are resolved inside it; without one FILE is refused
+static std::string g_graph_dir;
+
+// Memory budget (argv[2], MiB), shared by all connections: the graph of every request in flight and every
+// connection's KEEP graph hold a reservation in it, so concurrent requests cannot overcommit it together
+static MemoryBudget g_budget(std::size_t(1024) << 20);
+
+// Reserve the estimated size of a graph before allocating it (throws std::length_error)
+static MemoryReservation reserve_graph_memory(int vertices, std::size_t edges, bool directed)
+{
+    return MemoryReservation(g_budget, Graph::estimate_memory(vertices, edges, directed).total());
+}
+
+// A result computed on the stored graph of a connection, for one ALG and parameter set, valid at version
+struct KeptResult
+{
+    std::string key;
+    std::uint64_t version;
+    std::string value;
+};
+
+/*
+Whether a result of alg is still valid after the logged changes: SCC and clique counts depend on the edges
+only, not on their capacities, so they survive any number of SETW changes. Everything else (and any edge
+added or removed) is recomputed.
+*/
+static bool result_holds(const string& alg, const std::vector<Graph::Change>& changes)
+{
+    if (alg != "SCC" && alg != "CLIQUES")
+    {
+        return false;
+    }
+    return std::all_of(changes.begin(), changes.end(), [](const Graph::Change& c) { return c.kind == Graph::Change::Kind::SetWeight; });
+}
+
+/*
+Check the lines of an UPDATE against the stored graph before anything is applied: vertices in range,
+capacities >= 1, and an edge left for every REMOVE and SETW once the lines before it are applied
+(additions, then the DUPLICATES merge, then removals, then capacity changes, the order they are applied in).
+Returns the error to send, empty if the whole UPDATE can be applied. g is not modified (under DUPLICATES REJECT
+its check pass runs on it, which only throws).
+*/
+static std::string check_update(Graph& g, const std::pmr::vector<GraphEdge>& additions,
+                                const vector<GraphEdge>& removals, const vector<GraphEdge>& reweights,
+                                DuplicateEdgePolicy duplicates)
+{
+    const int V = g.get_vertices();
+    auto inRange = [V](const GraphEdge& e) { return e.u >= 0 && e.v >= 0 && e.u < V && e.v < V; };
+    for (const auto& e : additions)
     {
-        for (int u=0; u<V; ++u) for (int v=u+1; v<V; ++v) 
+        if (!inRange(e)) { return "Invalid EDGE vertex (out of range)"; }
+        if (e.w <= 0)    { return "Invalid EDGE weight (must be >=1)"; }
+    }
+    for (const auto& e : removals)
+    {
+        if (!inRange(e)) { return "Invalid REMOVE vertex (out of range)"; }
+    }
+    for (const auto& e : reweights)
+    {
+        if (!inRange(e)) { return "Invalid SETW vertex (out of range)"; }
+        if (e.w <= 0)    { return "Invalid SETW weight (must be >=1)"; }
+    }
+    if (duplicates == DuplicateEdgePolicy::Reject)
+    {
+        try
+        {
+            g.collapse_duplicate_edges(duplicates);
+        }
+        catch (const std::exception& ex)
         {
-            int w = cap[u][v] > 0 ? cap[u][v] : cap[v][u];
-            if (w > 0) out << "EDGE " << u << " " << v << " " << w << "\n";
+            return ex.what();
         }
     }
-    return out.str();
+
+    // Copies of every u-v edge the lines refer to (an undirected pair is one key), counted from the graph on
+    // first use; the merging policies leave at most one copy after the additions
+    const bool merging = duplicates != DuplicateEdgePolicy::Multigraph && duplicates != DuplicateEdgePolicy::Reject;
+    std::map<std::pair<int,int>, long long> copies;
+    auto count = [&](int u, int v) -> long long&
+    {
+        if (!g.is_directed() && v < u) { std::swap(u, v); }
+        auto it = copies.find({u, v});
+        if (it == copies.end())
+        {
+            long long c = 0;
+            for (auto x : g.get_neighbors(u)) { c += (x == v); }
+            if (!g.is_directed() && u == v) { c /= 2; } // an undirected self-loop is stored twice in one list
+            it = copies.emplace(std::make_pair(u, v), merging ? std::min(c, 1LL) : c).first;
+        }
+        return it->second;
+    };
+    for (const auto& e : additions)
+    {
+        if (++count(e.u, e.v) > 1 && duplicates == DuplicateEdgePolicy::Reject)
+        {
+            return "Duplicate edge " + std::to_string(e.u) + " " + std::to_string(e.v) + " (DUPLICATES REJECT)";
+        }
+    }
+    if (merging)
+    {
+        for (auto& c : copies) { c.second = std::min(c.second, 1LL); }
+    }
+    for (const auto& e : removals)
+    {
+        if (count(e.u, e.v)-- < 1)
+        {
+            return "REMOVE: no edge " + std::to_string(e.u) + " " + std::to_string(e.v);
+        }
+    }
+    for (const auto& e : reweights)
+    {
+        if (count(e.u, e.v) < 1)
+        {
+            return "SETW: no edge " + std::to_string(e.u) + " " + std::to_string(e.v);
+        }
+    }
+    return "";
 }
 
 void handle_client(int fd)
 {
     // Persistent per-connection loop: handle multiple requests on the same TCP connection
     // until the client sends EXIT or the socket closes.
+    std::optional<Graph> kept; // graph stored by KEEP 1, mutated in place by UPDATE 1 requests
+    MemoryReservation keptMemory; // its share of the memory budget, until the connection ends or it is replaced
+    std::vector<KeptResult> keptResults; // results computed on it (see result_holds)
     while (true)
     {
         // 1) Read a whole request into 'req' (terminated by an END line or EXIT)
@@ -280,6 +434,14 @@ void handle_client(int fd)
             return; 
         }
 
+        /*
+        Per-request arena: the edge list, the graph and the algorithms' scratch arrays are carved out of one
+        monotonic buffer and released together when this iteration ends (no per-object frees, and the
+        Leader–Follower workers stop contending on the global heap for every vector they grow).
+        Anything that outlives the request (the KEEP graph) is copied out to the default heap.
+        */
+        std::pmr::monotonic_buffer_resource arena(64 * 1024);
+
         // 3) Parse the line-based protocol into local variables
         std::istringstream iss(req);
         string line;
@@ -289,13 +451,17 @@ void handle_client(int fd)
         int directed=0;             // 0=undirected, 1=directed
         int randomFlag=0;           // 0=use provided EDGE lines, 1=generate random graph
         int seed=42;                // seed for deterministic random graph
+        GeneratorVersion generator = GeneratorVersion::Latest; // algorithm the seed is replayed with (GENERATOR)
+        GraphModel model;           // random graph family (MODEL), uniform by default
         int src=-1,sink=-1,k=-1;    // optional algorithm parameters
         int wmin=1,wmax=1;          // weight range for random graph
-        struct Edge
-        {
-            int u,v,w;             // explicit edges when RANDOM=0
-        };
-        vector<Edge> edges;
+        std::pmr::vector<GraphEdge> edges(&arena); // explicit edges when RANDOM=0
+        string graphFile;           // pre-built binary graph file (FILE), overrides V/EDGE/RANDOM
+        DuplicateEdgePolicy duplicates = DuplicateEdgePolicy::Multigraph; // repeated EDGE lines (DUPLICATES)
+        int keep=0;                 // 1=store the graph of this request on the connection
+        int update=0;               // 1=apply EDGE/REMOVE/SETW lines to the stored graph instead of building one
+        vector<GraphEdge> removals; // REMOVE u v (UPDATE only)
+        vector<GraphEdge> reweights;// SETW u v w (UPDATE only)
         bool parse_error=false;
         string perr;
 
@@ -346,11 +512,107 @@ void handle_client(int fd)
                 // EDGE u v [w] — optional weight (default 1)
                 std::istringstream ls(line);
                 string t;
-                int u,v,w=1;
+                int u=-1,v=-1,w=1;
                 ls>>t>>u>>v;
                 if (ls>>w){}
                 edges.push_back({u,v,w});
             }
+            else if (line.rfind("KEEP ",0)==0) 
+            {
+                std::istringstream ls(line);
+                string t;
+                ls>>t>>keep; 
+            }
+            else if (line.rfind("UPDATE ",0)==0) 
+            {
+                std::istringstream ls(line);
+                string t;
+                ls>>t>>update; 
+            }
+            else if (line.rfind("REMOVE ",0)==0) 
+            {
+                // REMOVE u v — drop one u->v edge of the stored graph
+                std::istringstream ls(line);
+                string t;
+                int u=-1,v=-1;
+                if (!(ls>>t>>u>>v))
+                {
+                    parse_error=true;
+                    perr = string("Malformed REMOVE line (expected REMOVE u v): ")+line;
+                    break;
+                }
+                removals.push_back({u,v,1});
+            }
+            else if (line.rfind("SETW ",0)==0) 
+            {
+                // SETW u v w — new capacity of the u->v edge of the stored graph
+                std::istringstream ls(line);
+                string t;
+                int u=-1,v=-1,w=0;
+                if (!(ls>>t>>u>>v>>w))
+                {
+                    parse_error=true;
+                    perr = string("Malformed SETW line (expected SETW u v w): ")+line;
+                    break;
+                }
+                reweights.push_back({u,v,w});
+            }
+            else if (line.rfind("MODEL ",0)==0) 
+            {
+                // MODEL uniform|rmat[:a,b,c]|ba[:m]|grid2d|grid3d|cliques:size[,count] — random graph family
+                try
+                {
+                    model = parse_graph_model(line.substr(6));
+                }
+                catch (const std::invalid_argument& ex)
+                {
+                    parse_error=true;
+                    perr = ex.what();
+                    break;
+                }
+            }
+            else if (line.rfind("GENERATOR ",0)==0) 
+            {
+                // GENERATOR 1|2|3 — random graph algorithm (see part_1/edge_sampling.hpp), default the latest
+                try
+                {
+                    generator = generator_version(std::stoi(line.substr(10)));
+                }
+                catch (const std::exception& ex)
+                {
+                    parse_error=true;
+                    perr = std::string("invalid GENERATOR: ") + ex.what();
+                    break;
+                }
+            }
+            else if (line.rfind("DUPLICATES ",0)==0) 
+            {
+                // DUPLICATES MULTI|REJECT|LAST|MAX|SUM — what to do with repeated edges (default MULTI: keep all)
+                try
+                {
+                    duplicates = parse_duplicate_policy(line.substr(11));
+                }
+                catch (const std::invalid_argument& ex)
+                {
+                    parse_error=true;
+                    perr = ex.what();
+                    break;
+                }
+            }
+            else if (line.rfind("FILE ",0)==0) 
+            {
+                // FILE <name> — binary graph file (see part_1/graph_file.hpp) inside the graph directory, replaces V/EDGE/RANDOM
+                try
+                {
+                    graphFile = resolve_graph_path(g_graph_dir, line.substr(5));
+                }
+                catch (const std::runtime_error& ex)
+                {
+                    parse_error=true;
+                    perr = ex.what();
+                    break;
+                }
+            }
             else if (line.rfind("WMIN ",0)==0) 
             {
                 std::istringstream ls(line);
@@ -390,7 +652,12 @@ void handle_client(int fd)
             send_response(fd, perr, false);
             continue; 
         }
-        if (V<=0) 
+        if (update && !kept) 
+        {
+            send_response(fd, "No stored graph (send KEEP 1 first)", false);
+            continue; 
+        }
+        if (V<=0 && graphFile.empty() && !update) 
         {
             send_response(fd, "Missing/invalid V", false);
             continue; 
@@ -404,10 +671,87 @@ void handle_client(int fd)
         // 5–7) Build + params + dispatch, with validation and exception safety
         try
         {
-            // 5) Build the Graph according to the request (explicit edges or generated random)
-            Graph g(V, directed!=0);
+            // 5) Build the Graph according to the request (mapped file, explicit edges or generated random),
+            // or take the stored one and mutate it in place
+            std::optional<MappedGraph> file;
+            MemoryReservation reservation; // released when this request ends, or handed to keptMemory by KEEP
+            if (update)
+            {
+                // the stored graph grows by the new EDGE lines: reserve the growth next to what it holds already
+                std::size_t now = Graph::estimate_memory(kept->get_vertices(), kept->get_edges(), kept->is_directed()).total();
+                reservation = MemoryReservation(g_budget, Graph::estimate_memory(kept->get_vertices(), kept->get_edges() + edges.size(), kept->is_directed()).total() - now);
+            }
+            else if (graphFile.empty())
+            {
+                long long maxE = directed ? 1LL*V*(V-1) : 1LL*V*(V-1)/2;
+                std::size_t requested = static_cast<std::size_t>(std::max(0LL, std::min<long long>(E, maxE)));
+                reservation = reserve_graph_memory(V, randomFlag ? static_cast<std::size_t>(model.max_edges(V, static_cast<int>(requested), directed!=0)) : edges.size(), directed!=0);
+            }
+            else
+            {
+                file.emplace(graphFile); // mapped and validated, copied into the Graph below
+                reservation = reserve_graph_memory(file->get_vertices(), static_cast<std::size_t>(file->get_edges()), file->is_directed());
+            }
+            if (randomFlag && !update)
+            {
+                // Clamp E to a feasible range and normalize the weight range before generating
+                long long maxE = directed ? 1LL*V*(V-1) : 1LL*V*(V-1)/2; // maximum simple edges possible (64-bit: V*(V-1) overflows int for large V)
+                if (E > maxE) { E = (int)maxE; }
+                if (E < 0)     { E = 0;    }
+                if (wmax < wmin) { std::swap(wmax, wmin); }
+            }
 
-            if (!randomFlag)
+            // PREVIEW of a generated graph that is not kept needs nothing but its text: the edges are written
+            // into it while they are generated, no Graph or edge list is built
+            if (randomFlag && !update && !keep && graphFile.empty() && alg == "PREVIEW")
+            {
+                PreviewWriter preview;
+                if (model.kind == GraphModel::Uniform)
+                {
+                    generate_random_edges(V, E, seed, directed!=0, wmin, wmax, preview, generator);
+                }
+                else
+                {
+                    generate_model_edges(model, V, E, seed, directed!=0, wmin, wmax, preview);
+                }
+                send_response(fd, preview.text, true);
+                continue;
+            }
+
+            // A graph that will be kept is allocated on the default heap (it outlives the arena), so KEEP moves
+            // it instead of copying it
+            std::pmr::memory_resource* graphMemory = keep && !update ? std::pmr::get_default_resource() : &arena;
+            Graph built = (graphFile.empty() || update) ? Graph(update ? 1 : V, directed!=0, graphMemory) : file->to_graph(graphMemory);
+            Graph& g = update ? *kept : built;
+
+            if (update)
+            {
+                // All lines are checked first, so an UPDATE is applied completely or not at all
+                directed = g.is_directed() ? 1 : 0;
+                std::string err = check_update(g, edges, removals, reweights, duplicates);
+                if (!err.empty())
+                {
+                    send_response(fd, err, false);
+                    continue;
+                }
+                g.addEdges(edges.data(), edges.size());
+                g.collapse_duplicate_edges(duplicates);
+                for (const auto& e : removals)
+                {
+                    g.removeEdge(e.u, e.v);
+                }
+                for (const auto& e : reweights)
+                {
+                    g.setWeight(e.u, e.v, e.w);
+                }
+            }
+            else if (!graphFile.empty())
+            {
+                // The file decides the orientation
+                directed = g.is_directed() ? 1 : 0;
+                g.collapse_duplicate_edges(duplicates);
+            }
+            else if (!randomFlag)
             {
                 // Validate all explicit edges BEFORE addEdge to avoid abort/throw inside Graph
                 bool bad = false;
@@ -432,20 +776,30 @@ void handle_client(int fd)
                     continue;
                 }
 
-                // Now it's safe to add
-                for (const auto &e : edges)
-                {
-                    g.addEdge(e.u, e.v, e.w);
-                }
+                // Now it's safe to build (multi-threaded for large edge lists, see graph_builder.hpp);
+                // repeated edges are merged/rejected by the DUPLICATES policy while the lists are built
+                GraphBuildOptions options;
+                options.duplicates = duplicates;
+                options.resource = graphMemory;
+                g = ParallelGraphBuilder<int, int>(options).build(V, directed!=0, edges.data(), edges.size());
             }
             else
             {
-                // RANDOM=1: clamp E to a feasible range, normalize weight range, then generate.
-                int maxE = directed ? V*(V-1) : V*(V-1)/2; // maximum simple edges possible
-                if (E > maxE) { E = maxE; }
-                if (E < 0)     { E = 0;    }
-                if (wmax < wmin) { std::swap(wmax, wmin); }
-                g = generate_random_graph(V, E, seed, directed!=0, wmin, wmax);
+                // RANDOM=1: generate (E and the weight range were normalized above)
+                g = model.kind == GraphModel::Uniform ? generate_random_graph(V, E, seed, directed!=0, wmin, wmax, graphMemory, generator)
+                                                      : generate_model_graph(model, V, E, seed, directed!=0, wmin, wmax, graphMemory);
+            }
+
+            // The estimate becomes the real size (for UPDATE the stored graph's share is resized, the growth
+            // reservation is then no longer needed)
+            if (update)
+            {
+                keptMemory.resize(g.memory_usage().total());
+                reservation.reset();
+            }
+            else
+            {
+                reservation.resize(g.memory_usage().total());
             }
 
             // 6) Prepare algorithm parameters map (only include provided keys)
@@ -454,6 +808,35 @@ void handle_client(int fd)
             if (sink >= 0) { params["SINK"] = sink; }
             if (k    >= 0) { params["K"]    = k;    }
 
+            // On the stored graph (UPDATE, or a graph about to be kept) results are cached per connection and
+            // reused as long as the changes logged since they were computed cannot affect them
+            bool stored = update || keep;
+            if (keep && !update)
+            {
+                keptResults.clear(); // a new stored graph
+            }
+            auto run_alg = [&](const string& name)
+            {
+                if (!stored)
+                {
+                    return run_alg_or_error(name, g, params, directed!=0, &arena);
+                }
+                string key = name + " " + std::to_string(src) + " " + std::to_string(sink) + " " + std::to_string(k);
+                auto it = std::find_if(keptResults.begin(), keptResults.end(), [&](const KeptResult& r) { return r.key == key; });
+                if (it == keptResults.end())
+                {
+                    keptResults.push_back({key, g.version(), run_alg_or_error(name, g, params, directed!=0, &arena)});
+                    return keptResults.back().value;
+                }
+                std::vector<Graph::Change> changes;
+                if (it->version != g.version() && !(g.changes_since(it->version, changes) && result_holds(name, changes)))
+                {
+                    it->value = run_alg_or_error(name, g, params, directed!=0, &arena);
+                }
+                it->version = g.version();
+                return it->value;
+            };
+
             // 7) Dispatch by ALG and send a response
             if (alg == "PREVIEW")
             {
@@ -465,10 +848,10 @@ void handle_client(int fd)
             {
                 // Compute all algorithms sequentially and send one consolidated OK block.
                 std::ostringstream body;
-                string r1 = run_alg_or_error("MAX_FLOW",  g, params, directed!=0);
-                string r2 = run_alg_or_error("SCC",       g, params, directed!=0);
-                string r3 = run_alg_or_error("MST",       g, params, directed!=0);
-                string r4 = run_alg_or_error("CLIQUES",   g, params, directed!=0);
+                string r1 = run_alg("MAX_FLOW");
+                string r2 = run_alg("SCC");
+                string r3 = run_alg("MST");
+                string r4 = run_alg("CLIQUES");
                 body << "RESULT MAX_FLOW="   << r1 << "\n";
                 body << "RESULT SCC_COUNT="  << r2 << "\n";
                 body << "RESULT MST_WEIGHT=" << r3 << "\n";
@@ -478,9 +861,27 @@ void handle_client(int fd)
             else
             {
                 // Single-algorithm request
-                auto out = run_alg_or_error(alg, g, params, directed!=0);
+                auto out = run_alg(alg);
                 send_response(fd, out, true);
             }
+
+            // KEEP 1: this graph becomes the stored graph of the connection (UPDATE requests keep mutating it)
+            if (keep && !update)
+            {
+                kept.emplace(std::move(built)); // allocated on the default heap above, no copy
+                kept->enable_change_log();      // from its current version, the one the cached results have
+                keptMemory = std::move(reservation);
+            }
+            if (stored && kept)
+            {
+                // The log is only needed back to the oldest cached result
+                std::uint64_t oldest = kept->version();
+                for (const auto& r : keptResults)
+                {
+                    oldest = std::min(oldest, r.version);
+                }
+                kept->trim_change_log(oldest);
+            }
         }
         catch (const std::exception& ex)
         {
@@ -507,6 +908,20 @@ int run_server(int argc, char *argv[])
             port=p;
         }
     }
+    // Memory budget in MiB: argv[2]
+    if (argc>=3) 
+    {
+        long long mib=std::atoll(argv[2]);
+        if(mib>0)
+        {
+            g_budget.set_limit(static_cast<std::size_t>(mib) << 20);
+        }
+    }
+    // Graph directory for FILE requests: argv[3]
+    if (argc>=4) 
+    {
+        g_graph_dir=argv[3];
+    }
 
     // 2) Create a TCP socket (IPv4, stream)
     int srv = socket(AF_INET, SOCK_STREAM, 0);
@@ -11,14 +11,22 @@
 #include <sstream>
 #include <string>
 #include <unordered_map>
+#include <map>
+#include <algorithm>
 #include <vector>
 #include <cstdlib>
 #include <thread>
 #include <mutex>
 #include <condition_variable>
 #include <future>
+#include <optional>
+#include <memory_resource>
+#include <charconv>
 
 #include "../../part_1/graph_impl.hpp"
+#include "../../part_1/graph_file.hpp"
+#include "../../part_1/memory_budget.hpp"
+#include "../../part_1/graph_builder.hpp"
 #include "../include/random_graph.hpp"
 #include "../../part_7/strategy_factory/AlgorithmFactory.hpp"
 
@@ -358,4 +358,34 @@ echo "[40] EDGE with non-numeric weight"
 printf "ALG MST\nDIRECTED 0\nV 3\nE 1\nEDGE 0 1 X\nEND\n" \
   | nc -N 127.0.0.1 "$PORT" > "$LOG_DIR/raw_edge_weight_nonnumeric.out" 2> "$LOG_DIR/raw_edge_weight_nonnumeric.err" || true
 
+# [41] Server: KEEP a graph, then UPDATE it in place on the same connection (EDGE/REMOVE/SETW)
+echo "[41] KEEP then UPDATE with EDGE/REMOVE/SETW"
+printf "ALG SCC\nDIRECTED 1\nV 4\nEDGE 0 1 2\nEDGE 1 0 3\nEDGE 2 3 1\nKEEP 1\nEND\nALG SCC\nUPDATE 1\nEDGE 3 2 1\nREMOVE 1 0\nSETW 0 1 5\nEND\nALG PREVIEW\nUPDATE 1\nEND\n" \
+  | nc -N 127.0.0.1 "$PORT" > "$LOG_DIR/raw_keep_update.out" 2> "$LOG_DIR/raw_keep_update.err" || true
+
+# [42] Server: UPDATE without a stored graph
+echo "[42] UPDATE without KEEP"
+printf "ALG PREVIEW\nUPDATE 1\nEDGE 0 1 1\nEND\n" \
+  | nc -N 127.0.0.1 "$PORT" > "$LOG_DIR/raw_update_no_keep.out" 2> "$LOG_DIR/raw_update_no_keep.err" || true
+
+# [43] Server: rejected UPDATEs leave the stored graph untouched (bad weight, missing edge, malformed lines)
+echo "[43] Rejected UPDATE lines"
+printf "ALG PREVIEW\nDIRECTED 1\nV 3\nEDGE 0 1 1\nKEEP 1\nEND\nALG PREVIEW\nUPDATE 1\nEDGE 1 2 0\nEND\nALG PREVIEW\nUPDATE 1\nEDGE 1 2 4\nREMOVE 2 0\nEND\nALG PREVIEW\nUPDATE 1\nSETW 0 1 0\nEND\nALG PREVIEW\nUPDATE 1\nREMOVE 0\nEND\nALG PREVIEW\nUPDATE 1\nSETW 0 1\nEND\nALG PREVIEW\nUPDATE 1\nSETW 0 7 2\nEND\nALG PREVIEW\nUPDATE 1\nEND\n" \
+  | nc -N 127.0.0.1 "$PORT" > "$LOG_DIR/raw_update_rejected.out" 2> "$LOG_DIR/raw_update_rejected.err" || true
+
+# [44] Server: UPDATE with a DUPLICATES policy, results reused across capacity changes
+echo "[44] UPDATE with DUPLICATES and cached results"
+printf "ALG ALL\nDIRECTED 0\nV 3\nEDGE 0 1 2\nEDGE 1 2 3\nPARAM K 2\nKEEP 1\nEND\nALG ALL\nUPDATE 1\nPARAM K 2\nSETW 1 2 1\nEND\nALG PREVIEW\nUPDATE 1\nDUPLICATES REJECT\nEDGE 1 0 5\nEND\nALG PREVIEW\nUPDATE 1\nDUPLICATES MAX\nEDGE 1 0 5\nEND\n" \
+  | nc -N 127.0.0.1 "$PORT" > "$LOG_DIR/raw_update_duplicates.out" 2> "$LOG_DIR/raw_update_duplicates.err" || true
+
+# [45] Server: GENERATOR versions (original, one-thread, parallel) and an unknown one
+echo "[45] GENERATOR versions"
+printf "ALG PREVIEW\nDIRECTED 0\nRANDOM 1\nV 6\nE 5\nSEED 4\nGENERATOR 1\nEND\nALG PREVIEW\nDIRECTED 0\nRANDOM 1\nV 6\nE 5\nSEED 4\nGENERATOR 2\nEND\nALG MST\nDIRECTED 0\nRANDOM 1\nV 6\nE 8\nSEED 4\nGENERATOR 3\nEND\nALG PREVIEW\nRANDOM 1\nV 6\nE 5\nGENERATOR 9\nEND\n" \
+  | nc -N 127.0.0.1 "$PORT" > "$LOG_DIR/raw_generator_versions.out" 2> "$LOG_DIR/raw_generator_versions.err" || true
+
+# [46] Server: MODEL graph families and an unknown model
+echo "[46] MODEL graph families"
+printf "ALG SCC\nDIRECTED 1\nRANDOM 1\nV 16\nE 40\nMODEL rmat\nEND\nALG MST\nDIRECTED 0\nRANDOM 1\nV 12\nE 24\nMODEL ba:2\nEND\nALG PREVIEW\nDIRECTED 0\nRANDOM 1\nV 9\nMODEL grid2d\nEND\nALG CLIQUES\nDIRECTED 0\nRANDOM 1\nV 10\nE 5\nMODEL cliques:4\nPARAM K 4\nEND\nALG PREVIEW\nRANDOM 1\nV 10\nMODEL tree\nEND\n" \
+  | nc -N 127.0.0.1 "$PORT" > "$LOG_DIR/raw_models.out" 2> "$LOG_DIR/raw_models.err" || true
+
 echo " All test runs completed."
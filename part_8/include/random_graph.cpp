@@ -1,4 +1,82 @@
 #include "../include/random_graph.hpp"
+#include "../../part_1/graph_builder.hpp"
+
+namespace
+{
+    // Edges handed to a sink at a time (a batch buffer of 3 MiB)
+    constexpr std::size_t EDGE_BATCH = std::size_t(1) << 18;
+
+    // Normalize weight range (ensure wmin <= wmax and wmin >= 1)
+    void normalize_weights(int& wmin, int& wmax)
+    {
+        if (wmin > wmax)
+        {
+            std::swap(wmin, wmax);
+        }
+        if (wmin < 1)
+        {
+            wmin = 1; // keep positive weights/capacities
+        }
+    }
+
+    // Hand a whole list to the sink: as it is, or in (u, v) order with undirected edges turned to u < v when the
+    // sink needs sorted input
+    void stream_list(std::vector<GraphEdge>& list, int vertices, bool directed, EdgeSink& sink)
+    {
+        if (sink.needs_sorted())
+        {
+            if (!directed)
+            {
+                for (auto& e : list)
+                {
+                    if (e.u > e.v)
+                    {
+                        std::swap(e.u, e.v);
+                    }
+                }
+            }
+            auto before = [](const GraphEdge& x, const GraphEdge& y) { return x.u != y.u ? x.u < y.u : x.v < y.v; };
+            if (!std::is_sorted(list.begin(), list.end(), before))
+            {
+                std::sort(list.begin(), list.end(), before);
+            }
+        }
+        sink.begin(vertices, directed, list.size());
+        for (std::size_t first = 0; first < list.size(); first += EDGE_BATCH)
+        {
+            sink.consume(list.data() + first, std::min(EDGE_BATCH, list.size() - first));
+        }
+        sink.finish();
+    }
+
+    /*
+    Edges of a benchmark family (R-MAT, Barabasi-Albert, grids, planted cliques; see part_1/graph_models.hpp).
+    The weight of the i-th edge of the model edge list comes from block i of the Philox weight stream, so the
+    graph depends on the seed only, like the Parallel version of generate_random_edges.
+    */
+    std::vector<GraphEdge> weighted_model_edges(const GraphModel& model, int vertices, int edges, int seed, bool directed,
+                                                int wmin, int wmax, unsigned threads)
+    {
+        const std::uint64_t key = static_cast<std::uint64_t>(seed);
+        std::vector<GraphEdge> list = model_edges(model, vertices, edges, directed, key, threads);
+        const std::uint64_t span = static_cast<std::uint64_t>(wmax) - static_cast<std::uint64_t>(wmin) + 1;
+        for (std::size_t i = 0; i < list.size(); ++i)
+        {
+            PhiloxStream weight(key, WEIGHT_STREAM, i);
+            list[i].w = wmin + static_cast<int>(uniform_below(span, weight));
+        }
+        return list;
+    }
+
+    Graph build(int vertices, bool directed, const std::vector<GraphEdge>& list, std::pmr::memory_resource* resource,
+                unsigned threads)
+    {
+        GraphBuildOptions options;
+        options.resource = resource;
+        options.threads = threads;
+        return build_graph_parallel(vertices, directed, list, options);
+    }
+}
 
 /*
     Generate a simple random graph with positive edge weights in [wmin, wmax].
@@ -7,26 +85,82 @@
     - seed: PRNG seed to make generation deterministic/repeatable
     - directed: if true, produce directed edges (u->v); otherwise undirected
     - wmin/wmax: inclusive weight range; wmin is normalized to be at least 1
+    - sink: receives the edges in batches of EDGE_BATCH, sorted by (u, v) except for Rejection (see below)
+    - version: Parallel (default) draws a uniform set of pairs in O(V + E) on several threads, every weight
+      from the Philox stream position of its pair, so the graph does not depend on the thread count;
+      Sampled draws the same way on one std::mt19937_64, then the weights in (u, v) order;
+      Rejection replays the original generator (std::mt19937, a std::set of used pairs): the edges come in draw
+      order, as drawn (the adjacency order of the original graphs), and are sorted only if the sink needs it
+    - threads: threads of the Parallel version (0 = one per core)
 
     Guarantees:
     - No self-loops (u != v)
     - No duplicate edges: for undirected we avoid adding both (u,v) and (v,u);
     for directed we avoid duplicate (u->v).
+    Throws invalid_argument when edges is negative or more than the number of pairs.
+    The sampled versions only hold the sorted pair indices (8 bytes per edge) and one batch of edges besides
+    what the sink builds.
 */
-Graph generate_random_graph(int vertices, int edges, int seed, bool directed, int wmin, int wmax)
+void generate_random_edges(int vertices, int edges, int seed, bool directed, int wmin, int wmax, EdgeSink& sink,
+                           GeneratorVersion version, unsigned threads)
 {
-    // Normalize weight range (ensure wmin <= wmax and wmin >= 1)
-    if (wmin > wmax) 
+    normalize_weights(wmin, wmax);
+
+    if (vertices <= 0)
     {
-        std::swap(wmin, wmax);
+        throw std::invalid_argument("number of vertices must be positive");
     }
-    if (wmin < 1)
+    if (edges < 0 || static_cast<std::uint64_t>(edges) > pair_count(vertices, directed))
     {
-        wmin = 1; // keep positive weights/capacities
-    } 
+        throw std::invalid_argument("number of edges must be between 0 and the number of vertex pairs");
+    }
+    const std::uint64_t span = static_cast<std::uint64_t>(wmax) - static_cast<std::uint64_t>(wmin) + 1;
 
-    // Prepare an empty graph with the requested orientation
-    Graph g(vertices, directed);
+    if (version == GeneratorVersion::Parallel)
+    {
+        // Uniform set of pair indices over Philox blocks; weight of pair i from block i of the weight stream.
+        // Every batch is decoded on all threads, then handed over.
+        const std::uint64_t key = static_cast<std::uint64_t>(seed);
+        std::vector<std::uint64_t> picked = parallel_sample_indices(pair_count(vertices, directed), edges, key, threads);
+        std::vector<GraphEdge> batch(std::min(EDGE_BATCH, picked.size()));
+        sink.begin(vertices, directed, picked.size());
+        for (std::size_t first = 0; first < picked.size(); first += EDGE_BATCH)
+        {
+            const std::size_t count = std::min(EDGE_BATCH, picked.size() - first);
+            const std::uint64_t* part = picked.data() + first;
+            parallel_decode(part, count, vertices, directed, threads, [&](std::size_t i, int u, int v)
+            {
+                PhiloxStream weight(key, WEIGHT_STREAM, part[i]);
+                batch[i] = {u, v, wmin + static_cast<int>(uniform_below(span, weight))};
+            });
+            sink.consume(batch.data(), count);
+        }
+        sink.finish();
+        return;
+    }
+    if (version == GeneratorVersion::Sampled)
+    {
+        // Uniform set of pair indices, sorted, decoded row by row; one weight per edge in that order
+        std::mt19937_64 rng64(static_cast<std::uint64_t>(seed));
+        std::vector<std::uint64_t> picked = sample_indices(pair_count(vertices, directed), edges, rng64);
+        std::vector<GraphEdge> batch;
+        batch.reserve(std::min(EDGE_BATCH, picked.size()));
+        PairDecoder pair(vertices, directed);
+        sink.begin(vertices, directed, picked.size());
+        for (std::uint64_t index : picked)
+        {
+            auto [u, v] = pair(index);
+            batch.push_back({u, v, wmin + static_cast<int>(uniform_below(span, rng64))});
+            if (batch.size() == EDGE_BATCH)
+            {
+                sink.consume(batch.data(), batch.size());
+                batch.clear();
+            }
+        }
+        sink.consume(batch.data(), batch.size());
+        sink.finish();
+        return;
+    }
 
     // RNG setup: deterministic PRNG seeded by 'seed'
     std::mt19937 rng(seed);
@@ -35,7 +169,11 @@ Graph generate_random_graph(int vertices, int edges, int seed, bool directed, in
     // Uniformly pick weights in [wmin, wmax]
     std::uniform_int_distribution<int> distW(wmin, wmax);
 
-    if (!directed) 
+    // Edges are collected in draw order (the weights depend on it), sorted only for a sink that needs it
+    std::vector<GraphEdge> list;
+    list.reserve(edges);
+
+    if (!directed)
     {
         // Undirected: track used unordered pairs (min(u,v), max(u,v)) to avoid duplicates
         std::set<std::pair<int, int>> used_edges;
@@ -54,19 +192,19 @@ Graph generate_random_graph(int vertices, int edges, int seed, bool directed, in
                 continue; // already have this undirected edge
             }
             int w = distW(rng);
-            g.addEdge(u, v, w);
+            list.push_back({u, v, w});
             used_edges.insert(e);
             ++added;
         }
     }
-    else 
+    else
     {
         // Directed: track used ordered pairs via a compact 64-bit key (u,v)
         std::set<long long> used;
         // lambda for generating unique keys for edges:
         auto key = [vertices](int u, int v)
         {
-             return (long long)u * (vertices + 1LL) + v; 
+             return (long long)u * (vertices + 1LL) + v;
         };
         int added = 0;
         while (added < edges)
@@ -76,18 +214,55 @@ Graph generate_random_graph(int vertices, int edges, int seed, bool directed, in
             if (u == v)
             {
                 continue; // skip self-loops
-            } 
+            }
             long long k = key(u,v);
             if (used.count(k))
             {
                 continue; // already have u->v
             }
             int w = distW(rng);
-            g.addEdge(u, v, w);
+            list.push_back({u, v, w});
             used.insert(k);
             ++added;
         }
     }
-    // Return the generated graph
-    return g;
+    stream_list(list, vertices, directed, sink);
+}
+
+// The generated edges collected into a list, then built by the parallel builder (requested orientation):
+// the full edge list, the builder's contiguous arrays and the Graph exist together at the peak
+Graph generate_random_graph(int vertices, int edges, int seed, bool directed, int wmin, int wmax, std::pmr::memory_resource* resource,
+                            GeneratorVersion version, unsigned threads)
+{
+    EdgeListSink list;
+    generate_random_edges(vertices, edges, seed, directed, wmin, wmax, list, version, threads);
+    return build(vertices, directed, list.list, resource, threads);
+}
+
+// The models draw their whole list first (R-MAT and planted cliques merge repeated edges), sorted only for a
+// sink that needs it
+void generate_model_edges(const GraphModel& model, int vertices, int edges, int seed, bool directed, int wmin, int wmax,
+                          EdgeSink& sink, unsigned threads)
+{
+    normalize_weights(wmin, wmax);
+    if (model.kind == GraphModel::Uniform)
+    {
+        generate_random_edges(vertices, edges, seed, directed, wmin, wmax, sink, GeneratorVersion::Latest, threads);
+        return;
+    }
+    std::vector<GraphEdge> list = weighted_model_edges(model, vertices, edges, seed, directed, wmin, wmax, threads);
+    stream_list(list, vertices, directed, sink);
+}
+
+// Built straight from the model list (no sorting needed, the builder takes any order)
+Graph generate_model_graph(const GraphModel& model, int vertices, int edges, int seed, bool directed, int wmin, int wmax,
+                           std::pmr::memory_resource* resource, unsigned threads)
+{
+    normalize_weights(wmin, wmax);
+    if (model.kind == GraphModel::Uniform)
+    {
+        return generate_random_graph(vertices, edges, seed, directed, wmin, wmax, resource, GeneratorVersion::Latest, threads);
+    }
+    return build(vertices, directed, weighted_model_edges(model, vertices, edges, seed, directed, wmin, wmax, threads),
+                 resource, threads);
 }
@@ -1,7 +1,28 @@
 #pragma once
 #include "../../part_1/graph_impl.hpp"
+#include "../../part_1/edge_sampling.hpp"
+#include "../../part_1/graph_models.hpp"
+#include "../../part_1/edge_sink.hpp"
 #include <random>
 #include <set>
+#include <memory_resource>
 
 // Directed/undirected random graph generator with integer weights in [wmin,wmax]
-Graph generate_random_graph(int vertices, int edges, int seed, bool directed, int wmin, int wmax);
+// (lists allocated from resource, nullptr = default heap; version: the algorithm a seed is replayed with,
+// see edge_sampling.hpp; threads: threads of the Parallel version and of the graph builder, 0 = one per core)
+Graph generate_random_graph(int vertices, int edges, int seed, bool directed, int wmin, int wmax,
+                            std::pmr::memory_resource* resource = nullptr,
+                            GeneratorVersion version = GeneratorVersion::Latest, unsigned threads = 0);
+
+// Graph of a benchmark family (graph_models.hpp) with weights in [wmin,wmax]; the Uniform model is
+// generate_random_graph with the latest version
+Graph generate_model_graph(const GraphModel& model, int vertices, int edges, int seed, bool directed, int wmin, int wmax,
+                           std::pmr::memory_resource* resource = nullptr, unsigned threads = 0);
+
+// The same graphs streamed into a sink (edge_sink.hpp) instead of built, so the consumer builds its own form
+// without a Graph in between: the edges arrive in batches, sorted by (u, v) with undirected edges as u < v when
+// the version samples sorted pairs or the sink needs it, otherwise in draw order (the order the Graph is built in)
+void generate_random_edges(int vertices, int edges, int seed, bool directed, int wmin, int wmax, EdgeSink& sink,
+                           GeneratorVersion version = GeneratorVersion::Latest, unsigned threads = 0);
+void generate_model_edges(const GraphModel& model, int vertices, int edges, int seed, bool directed, int wmin, int wmax,
+                          EdgeSink& sink, unsigned threads = 0);
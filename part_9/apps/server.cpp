@@ -32,10 +32,53 @@ static void sigterm_handler(int) {;
 
 // Forward declarations for helpers used in pipeline stages:
 
-static std::string run_alg_or_error(const std::string& alg, const Graph& g,
+template <typename G>
+static std::string run_alg_or_error(const std::string& alg, const G& g,
                                     const std::unordered_map<std::string,int>& params,
-                                    bool requestedDirected);
-static std::string serialize_graph_edges(const Graph& g, bool directed);
+                                    bool requestedDirected, std::pmr::memory_resource* scratch);
+template <typename G>
+static std::string serialize_graph_edges(const G& g, bool directed);
+
+// Results of earlier requests, keyed by graph fingerprint + algorithm + orientation + parameters:
+static ResultCache g_results(256);
+
+// Graph directory (argv[3]): FILE names are resolved inside it; without one FILE is refused
+static std::string g_graph_dir;
+
+// Memory budget (argv[2], MiB): graphs of queued jobs plus the graph of a new request must fit in it.
+// A request reserves its estimate before building (released on every early return), the job then holds its real
+// size until the aggregator sends the response:
+static MemoryBudget g_budget(std::size_t(1024) << 20);
+
+// Reserve the estimated size of a graph next to the jobs already in the pipeline (throws std::length_error)
+static MemoryReservation reserve_graph_memory(int vertices, std::size_t edges, bool directed)
+{
+    return MemoryReservation(g_budget, Graph::estimate_memory(vertices, edges, directed).total());
+}
+
+// Run one algorithm on whichever representation the job carries (compressed or plain),
+// unless the same computation on the same graph content is already cached:
+static std::string run_job_alg(const std::string& alg, const Job& job)
+{
+    std::string key = job.fingerprint.to_string() + " " + alg + (job.directed ? " D" : " U");
+    for (const char* name : {"SRC", "SINK", "K"})
+    {
+        auto it = job.params.find(name);
+        if (it != job.params.end()) key += std::string(" ") + name + "=" + std::to_string(it->second);
+    }
+
+    std::string result;
+    if (g_results.get(key, result))
+    {
+        return result;
+    }
+    // The algorithm's scratch arrays live in an arena released in one shot when this stage is done with the job
+    std::pmr::monotonic_buffer_resource arena(64 * 1024);
+    result = job.compressed ? run_alg_or_error(alg, *job.compressed, job.params, job.directed, &arena)
+                            : run_alg_or_error(alg, *job.graph, job.params, job.directed, &arena);
+    g_results.put(key, result);
+    return result;
+}
 
 // Check if peer has already closed its write side:
 static bool peer_already_closed_write(int fd);
@@ -92,7 +135,7 @@ namespace
             //Wait for jobs and process them:
             while (q_max_flow.pop(job))
             {
-                job.res_max_flow = run_alg_or_error("MAX_FLOW", job.graph, job.params, job.directed); // run max-flow
+                job.res_max_flow = run_job_alg("MAX_FLOW", job); // run max-flow
 
                 // If it is single max-flow request, send to aggregator, else to next stage:
                 if (job.kind == AlgKind::SINGLE_MAX_FLOW) q_agg.push(std::move(job)); 
@@ -115,7 +158,7 @@ namespace
             Job job;
             while (q_scc.pop(job))
             {
-                job.res_scc = run_alg_or_error("SCC", job.graph, job.params, job.directed); // run SCC
+                job.res_scc = run_job_alg("SCC", job); // run SCC
 
                 // If single SCC request, send to aggregator, else to next stage:
                 if (job.kind == AlgKind::SINGLE_SCC) q_agg.push(std::move(job));
@@ -137,7 +180,7 @@ namespace
             Job job;
             while (q_mst.pop(job))
             {
-                job.res_mst = run_alg_or_error("MST", job.graph, job.params, job.directed); // run MST
+                job.res_mst = run_job_alg("MST", job); // run MST
 
                 // If single MST request, send to aggregator, else to next stage:
                 if (job.kind == AlgKind::SINGLE_MST) q_agg.push(std::move(job));
@@ -159,7 +202,7 @@ namespace
             Job job;
             while (q_cliques.pop(job))
             {
-                job.res_cliques = run_alg_or_error("CLIQUES", job.graph, job.params, job.directed); // run cliques
+                job.res_cliques = run_job_alg("CLIQUES", job); // run cliques
                 // If single cliques request, send to aggregator:
                 q_agg.push(std::move(job));
             }
@@ -179,9 +222,13 @@ namespace
             // Wait for jobs and send responses:
             while (q_agg.pop(job))
             {   
+                g_budget.release(job.bytes); // the job leaves the pipeline with this iteration
+
                 // Handle PREVIEW and single-algorithm requests separately:
                 if (job.kind == AlgKind::PREVIEW) {
-                    auto body = serialize_graph_edges(job.graph, job.directed); // serialize graph edges
+                    auto body = !job.preview.empty() ? std::move(job.preview)
+                              : job.compressed ? serialize_graph_edges(*job.compressed, job.directed)
+                                            : serialize_graph_edges(*job.graph, job.directed); // serialize graph edges
                     send_response(job.fd, body, true);
 
                     // Close connection if peer already closed write side:
@@ -465,9 +512,11 @@ static string trim_cr(string s)
     return s;
 }
 
-// Helper function for running an algorithm and handling errors
-static string run_alg_or_error(const string& alg, const Graph& g,
-                               const unordered_map<string,int>& params, bool requestedDirected)
+// Helper function for running an algorithm and handling errors (G is Graph or CompressedGraph)
+template <typename G>
+static string run_alg_or_error(const string& alg, const G& g,
+                               const unordered_map<string,int>& params, bool requestedDirected,
+                               std::pmr::memory_resource* scratch)
 {
     bool isDirectedAlg = (alg == "MAX_FLOW" || alg == "SCC");
     bool okForThisGraph = (requestedDirected && isDirectedAlg) || (!requestedDirected && !isDirectedAlg);
@@ -499,67 +548,97 @@ static string run_alg_or_error(const string& alg, const Graph& g,
     }
 
     // Create algorithm instance and run it, using the factory:
-    auto ptr = AlgorithmFactory::create(alg);
+    auto ptr = AlgorithmFactory::create(alg, scratch);
     if (!ptr) return "Unsupported algorithm";
     return ptr->run(g, params);
 }
 
 
-// Helper function for serializing graph edges
-static std::string serialize_graph_edges(const Graph& g, bool directed)
+// Helper function for serializing graph edges (G is Graph or CompressedGraph)
+template <typename G>
+static std::string serialize_graph_edges(const G& g, bool directed)
 {
-    const auto& cap = g.get_capacity();
-    std::ostringstream out;
+    /*
+    Walk the sparse edge storage instead of a VxV matrix:
+    *Collect (u, v, w) for every stored edge (for undirected graphs only u < v, each edge is stored twice).
+    *Sort by (u, v) so the output order is stable, and if the same pair was added more than once
+    keep the most recently added weight (stable sort keeps insertion order inside a run).
+    */
+    struct OutEdge
+    {
+        int u, v, w;
+    };
     int V = g.get_vertices();
-    int count = 0;
-    // First count edges for header
-    if (directed) 
+    std::vector<OutEdge> list;
+    list.reserve(g.get_edges());
+    for (int u=0; u<V; ++u)
     {
-        for (int u=0; u<V; ++u)
+        g.for_each_arc(u, [&](auto target, auto w)
         {
-            for (int v=0; v<V; ++v)
+            int v = static_cast<int>(target);
+            if (directed || u < v)
             {
-                if (cap[u][v] > 0)
-                {
-                    ++count;
-                }
+                list.push_back({u, v, static_cast<int>(w)});
             }
-        } 
+        });
     }
-    else 
+    std::stable_sort(list.begin(), list.end(), [](const OutEdge& a, const OutEdge& b)
     {
-        for (int u=0; u<V; ++u)
+        return a.u != b.u ? a.u < b.u : a.v < b.v;
+    });
+
+    std::vector<OutEdge> unique_edges;
+    unique_edges.reserve(list.size());
+    for (size_t i=0; i<list.size(); ++i)
+    {
+        bool lastOfRun = (i+1 == list.size()) || list[i+1].u != list[i].u || list[i+1].v != list[i].v;
+        if (lastOfRun && list[i].w > 0)
         {
-            for (int v=u+1; v<V; ++v)
-            {
-                if (cap[u][v] > 0 || cap[v][u] > 0)
-                {
-                    ++count;
-                }
-            }
-        } 
+            unique_edges.push_back(list[i]);
+        }
     }
-    out << "GRAPH " << V << " " << count << "\n";
-    if (directed) 
+
+    std::ostringstream out;
+    out << "GRAPH " << V << " " << unique_edges.size() << "\n";
+    for (const auto& e : unique_edges)
     {
-        for (int u=0; u<V; ++u)
-        {
-           for (int v=0; v<V; ++v)
-           {
-               if (cap[u][v] > 0) out << "EDGE " << u << " " << v << " " << cap[u][v] << "\n";
-           }
-        } 
+        out << "EDGE " << e.u << " " << e.v << " " << e.w << "\n";
     }
-    else 
+    return out.str();
+}
+
+// PREVIEW of a generated graph, written while the generator streams it (edge_sink.hpp): the stream is asked to
+// be sorted by (u, v) with every pair once, so the text is what serialize_graph_edges prints for the built graph.
+// The response is sent as one body, so the whole text is held until the generator is done.
+class PreviewWriter : public EdgeSink
+{
+public:
+    void begin(int vertices, bool, std::size_t edges) override
+    {
+        text = "GRAPH " + std::to_string(vertices) + " " + std::to_string(edges) + "\n";
+    }
+
+    void consume(const GraphEdge* edges, std::size_t count) override
     {
-        for (int u=0; u<V; ++u) for (int v=u+1; v<V; ++v) 
+        char line[48];
+        for (std::size_t i = 0; i < count; ++i)
         {
-            int w = cap[u][v] > 0 ? cap[u][v] : cap[v][u];
-            if (w > 0) out << "EDGE " << u << " " << v << " " << w << "\n";
+            char* p = line + 5;
+            std::memcpy(line, "EDGE ", 5);
+            p = std::to_chars(p, line + sizeof(line), edges[i].u).ptr;
+            *p++ = ' ';
+            p = std::to_chars(p, line + sizeof(line), edges[i].v).ptr;
+            *p++ = ' ';
+            p = std::to_chars(p, line + sizeof(line), edges[i].w).ptr;
+            *p++ = '\n';
+            text.append(line, p);
         }
     }
-    return out.str();
-}
+
+    bool needs_sorted() const override { return true; }
+
+    std::string text;
+};
 
 void handle_client(int fd)
 {
@@ -600,13 +679,14 @@ void handle_client(int fd)
         int directed=0;             // 0=undirected, 1=directed
         int randomFlag=0;           // 0=use provided EDGE lines, 1=generate random graph
         int seed=42;                // seed for deterministic random graph
+        GeneratorVersion generator = GeneratorVersion::Latest; // algorithm the seed is replayed with (GENERATOR)
+        GraphModel model;           // random graph family (MODEL), uniform by default
         int src=-1,sink=-1,k=-1;    // optional algorithm parameters
         int wmin=1,wmax=1;          // weight range for random graph
-        struct Edge
-        {
-            int u,v,w;             // explicit edges when RANDOM=0
-        };
-        vector<Edge> edges;
+        vector<GraphEdge> edges;    // explicit edges when RANDOM=0
+        string graphFile;           // pre-built binary graph file (FILE), overrides V/EDGE/RANDOM
+        DuplicateEdgePolicy duplicates = DuplicateEdgePolicy::Multigraph; // repeated EDGE lines (DUPLICATES)
+        int compress=0;             // 1=keep the graph in compressed adjacency form (larger graphs fit in memory)
         bool parse_error=false;
         string perr;
 
@@ -662,6 +742,68 @@ void handle_client(int fd)
                 if (ls>>w){}
                 edges.push_back({u,v,w});
             }
+            else if (line.rfind("MODEL ",0)==0) 
+            {
+                // MODEL uniform|rmat[:a,b,c]|ba[:m]|grid2d|grid3d|cliques:size[,count] — random graph family
+                try
+                {
+                    model = parse_graph_model(line.substr(6));
+                }
+                catch (const std::invalid_argument& ex)
+                {
+                    parse_error=true;
+                    perr = ex.what();
+                    break;
+                }
+            }
+            else if (line.rfind("GENERATOR ",0)==0) 
+            {
+                // GENERATOR 1|2|3 — random graph algorithm (see part_1/edge_sampling.hpp), default the latest
+                try
+                {
+                    generator = generator_version(std::stoi(line.substr(10)));
+                }
+                catch (const std::exception& ex)
+                {
+                    parse_error=true;
+                    perr = std::string("invalid GENERATOR: ") + ex.what();
+                    break;
+                }
+            }
+            else if (line.rfind("DUPLICATES ",0)==0) 
+            {
+                // DUPLICATES MULTI|REJECT|LAST|MAX|SUM — what to do with repeated edges (default MULTI: keep all)
+                try
+                {
+                    duplicates = parse_duplicate_policy(line.substr(11));
+                }
+                catch (const std::invalid_argument& ex)
+                {
+                    parse_error=true;
+                    perr = ex.what();
+                    break;
+                }
+            }
+            else if (line.rfind("FILE ",0)==0) 
+            {
+                // FILE <name> — binary graph file (see part_1/graph_file.hpp) inside the graph directory, replaces V/EDGE/RANDOM
+                try
+                {
+                    graphFile = resolve_graph_path(g_graph_dir, line.substr(5));
+                }
+                catch (const std::runtime_error& ex)
+                {
+                    parse_error=true;
+                    perr = ex.what();
+                    break;
+                }
+            }
+            else if (line.rfind("COMPRESS ",0)==0) 
+            {
+                std::istringstream ls(line);
+                string t;
+                ls>>t>>compress; 
+            }
             else if (line.rfind("WMIN ",0)==0) 
             {
                 std::istringstream ls(line);
@@ -702,7 +844,7 @@ void handle_client(int fd)
             if (peer_already_closed_write(fd)) { close(fd); return; }
             continue; 
         }
-        if (V<=0) 
+        if (V<=0 && graphFile.empty()) 
         {
             send_response(fd, "Missing/invalid V", false);
             if (peer_already_closed_write(fd)) { close(fd); return; }
@@ -717,9 +859,48 @@ void handle_client(int fd)
             continue; 
         }
 
-        // 5) Build the Graph according to the request (explicit edges or generated random)
-        Graph g(V, directed!=0);
-        if (!randomFlag) 
+        // Refuse oversized graphs before allocating them (a FILE is checked once its header is read)
+        MemoryReservation reservation;
+        if (graphFile.empty())
+        {
+            long long maxE = directed? 1LL*V*(V-1) : 1LL*V*(V-1)/2;
+            std::size_t requested = randomFlag ? static_cast<std::size_t>(std::max(0LL, std::min<long long>(E, maxE))) : edges.size();
+            if (randomFlag)
+            {
+                requested = static_cast<std::size_t>(model.max_edges(V, static_cast<int>(requested), directed!=0));
+            }
+            try
+            {
+                reservation = reserve_graph_memory(V, requested, directed!=0);
+            }
+            catch (const std::length_error& ex)
+            {
+                send_response(fd, string("Exception: ") + ex.what(), false);
+                continue;
+            }
+        }
+
+        // 5) Build the Graph according to the request (mapped file, explicit edges or generated random)
+        Graph g(1, false);
+        string preview;                                  // PREVIEW text of a streamed random graph
+        std::shared_ptr<const CompressedGraph> streamed; // compressed lists of a streamed random graph
+        if (!graphFile.empty()) 
+        {
+            try
+            {
+                MappedGraph file(graphFile);
+                reservation = reserve_graph_memory(file.get_vertices(), static_cast<std::size_t>(file.get_edges()), file.is_directed());
+                g = file.to_graph();
+                g.collapse_duplicate_edges(duplicates);
+            }
+            catch (const std::exception& ex)
+            {
+                send_response(fd, string("Exception: ") + ex.what(), false);
+                continue;
+            }
+            directed = g.is_directed() ? 1 : 0; // the file decides the orientation
+        }
+        else if (!randomFlag) 
         {
             // Validate all edges before touching Graph to avoid asserts/abort
             bool bad = false;
@@ -738,18 +919,63 @@ void handle_client(int fd)
                 send_response(fd, err, false);
                 continue; // back to read next request
             }
-            for (auto &e : edges) {
-                g.addEdge(e.u, e.v, e.w);
+            // Multi-threaded for large edge lists (graph_builder.hpp); repeated edges follow the DUPLICATES policy
+            GraphBuildOptions options;
+            options.duplicates = duplicates;
+            try
+            {
+                g = build_graph_parallel(V, directed!=0, edges, options);
+            }
+            catch (const std::exception& ex)
+            {
+                send_response(fd, string("Exception: ") + ex.what(), false);
+                continue;
             }
         }
         else 
         {
             // RANDOM=1: clamp and normalize then generate
-            int maxE = directed? V*(V-1) : V*(V-1)/2;
-            if (E > maxE) E = maxE;
+            long long maxE = directed? 1LL*V*(V-1) : 1LL*V*(V-1)/2; // 64-bit: V*(V-1) overflows int for large V
+            if (E > maxE) E = (int)maxE;
             if (E < 0) E = 0;
             if (wmax < wmin) std::swap(wmax, wmin);
-            g = generate_random_graph(V, E, seed, directed!=0, wmin, wmax);
+            try
+            {
+                if (alg == "PREVIEW" || compress)
+                {
+                    // Only the text or the compressed lists are kept: they are written while the edges are
+                    // generated, without a Graph in between
+                    PreviewWriter writer;
+                    CompressedGraph::Builder builder;
+                    EdgeSink& out = alg == "PREVIEW" ? static_cast<EdgeSink&>(writer) : builder;
+                    if (model.kind == GraphModel::Uniform)
+                    {
+                        generate_random_edges(V, E, seed, directed!=0, wmin, wmax, out, generator);
+                    }
+                    else
+                    {
+                        generate_model_edges(model, V, E, seed, directed!=0, wmin, wmax, out);
+                    }
+                    if (alg == "PREVIEW")
+                    {
+                        preview = std::move(writer.text);
+                    }
+                    else
+                    {
+                        streamed = std::make_shared<const CompressedGraph>(builder.take());
+                    }
+                }
+                else
+                {
+                    g = model.kind == GraphModel::Uniform ? generate_random_graph(V, E, seed, directed!=0, wmin, wmax, nullptr, generator)
+                                                          : generate_model_graph(model, V, E, seed, directed!=0, wmin, wmax);
+                }
+            }
+            catch (const std::exception& ex)
+            {
+                send_response(fd, string("Exception: ") + ex.what(), false);
+                continue;
+            }
         }
 
 
@@ -771,7 +997,23 @@ void handle_client(int fd)
         // 7) Map ALG to pipeline kind and enqueue job
         Job job;
         job.fd = fd;
-        job.graph = std::move(g);
+        job.fingerprint = streamed ? streamed->fingerprint() : g.fingerprint();
+        if (!preview.empty())
+        {
+            job.preview = std::move(preview);
+        }
+        else if (streamed)
+        {
+            job.compressed = std::move(streamed);
+        }
+        else if (compress)
+        {
+            job.compressed = std::make_shared<const CompressedGraph>(g); // the plain graph is dropped with g
+        }
+        else
+        {
+            job.graph = make_snapshot(std::move(g));
+        }
         job.params = std::move(params);
         job.directed = (directed!=0);
 
@@ -788,7 +1030,10 @@ void handle_client(int fd)
             return;
         }
 
-        // Enqueue to appropriate entry queue
+        // The reservation becomes the real size of the job, released by the aggregator once it responds:
+        job.bytes = job.memory_bytes();
+        reservation.resize(job.bytes);
+        reservation.detach();
 
         // Enqueue to appropriate entry queue:
         if (job.kind == AlgKind::PREVIEW) 
@@ -833,6 +1078,20 @@ int run_server(int argc, char *argv[])
             port=p;
         }
     }
+    // Memory budget in MiB: argv[2]
+    if (argc>=3) 
+    {
+        long long mib=std::atoll(argv[2]);
+        if(mib>0)
+        {
+            g_budget.set_limit(static_cast<std::size_t>(mib) << 20);
+        }
+    }
+    // Graph directory for FILE requests: argv[3]
+    if (argc>=4) 
+    {
+        g_graph_dir=argv[3];
+    }
 
     // 2) Create a TCP socket (IPv4, stream)
     int srv = socket(AF_INET, SOCK_STREAM, 0);
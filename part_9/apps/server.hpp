@@ -17,12 +17,17 @@
 #include <mutex>
 #include <condition_variable>
 #include <future>
+#include <memory_resource>
+#include <charconv>
 #include <atomic>
 #include <signal.h>
 #include <system_error>
 #include <csignal>
 
 #include "../../part_1/graph_impl.hpp"
+#include "../../part_1/graph_file.hpp"
+#include "../../part_1/memory_budget.hpp"
+#include "../../part_1/graph_builder.hpp"
 // Reuse Part 8's random graph interface; implementation will be linked via makefile sources.
 #include "../../part_8/include/random_graph.hpp"
 #include "../../part_7/strategy_factory/AlgorithmFactory.hpp"
@@ -30,6 +35,7 @@
 // Pipeline includes:
 #include "../include/blocking_queue.hpp"
 #include "../include/pipeline.hpp"
+#include "../include/result_cache.hpp"
 
 #ifndef PORT
 #define PORT 9090
@@ -645,6 +645,21 @@ printf "ALG PREVIEW\nDIRECTED foo\nV 3\nE 0\nEND\n" \
   | timeout 5s nc $NC_CLOSE_OPT -w 2 127.0.0.1 "$PORT" \
   > "$LOG_DIR/raw_directed_text.out" 2> "$LOG_DIR/raw_directed_text.err" || true
 
+echo "[41.1] GENERATOR versions (original, one-thread, parallel) and an unknown one"
+printf "ALG PREVIEW\nDIRECTED 0\nRANDOM 1\nV 6\nE 5\nSEED 4\nGENERATOR 1\nEND\nALG PREVIEW\nDIRECTED 0\nRANDOM 1\nV 6\nE 5\nSEED 4\nGENERATOR 2\nEND\nALG MST\nDIRECTED 0\nRANDOM 1\nV 6\nE 8\nSEED 4\nGENERATOR 3\nEND\nALG PREVIEW\nRANDOM 1\nV 6\nE 5\nGENERATOR 9\nEND\n" \
+  | timeout 5s nc $NC_CLOSE_OPT -w 2 127.0.0.1 "$PORT" \
+  > "$LOG_DIR/raw_generator_versions.out" 2> "$LOG_DIR/raw_generator_versions.err" || true
+
+echo "[41.2] MODEL graph families and an unknown model"
+printf "ALG SCC\nDIRECTED 1\nRANDOM 1\nV 16\nE 40\nMODEL rmat\nEND\nALG MST\nDIRECTED 0\nRANDOM 1\nV 12\nE 24\nMODEL ba:2\nEND\nALG PREVIEW\nDIRECTED 0\nRANDOM 1\nV 9\nMODEL grid2d\nEND\nALG CLIQUES\nDIRECTED 0\nRANDOM 1\nV 10\nE 5\nMODEL cliques:4\nPARAM K 4\nEND\nALG PREVIEW\nRANDOM 1\nV 10\nMODEL tree\nEND\n" \
+  | timeout 5s nc $NC_CLOSE_OPT -w 2 127.0.0.1 "$PORT" \
+  > "$LOG_DIR/raw_models.out" 2> "$LOG_DIR/raw_models.err" || true
+
+echo "[41.3] COMPRESS 1 on explicit and generated graphs (same results as uncompressed)"
+printf "ALG ALL\nDIRECTED 0\nV 4\nEDGE 0 1 1\nEDGE 1 2 2\nEDGE 2 3 3\nEDGE 0 2 1\nPARAM K 3\nCOMPRESS 1\nEND\nALG SCC\nDIRECTED 1\nRANDOM 1\nV 20\nE 40\nSEED 7\nCOMPRESS 1\nEND\nALG SCC\nDIRECTED 1\nRANDOM 1\nV 20\nE 40\nSEED 7\nEND\nALG PREVIEW\nDIRECTED 0\nRANDOM 1\nV 8\nMODEL grid2d\nCOMPRESS 1\nEND\n" \
+  | timeout 5s nc $NC_CLOSE_OPT -w 2 127.0.0.1 "$PORT" \
+  > "$LOG_DIR/raw_compress.out" 2> "$LOG_DIR/raw_compress.err" || true
+
 
 echo "[42] Client: refuse ALL after PREVIEW (yn != '1')"
 cat > "$LOG_DIR/input_client_refuse_all.txt" <<'EOF'
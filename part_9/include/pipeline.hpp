@@ -14,10 +14,12 @@ declarations to start/stop the pipeline threads (implemented elsewhere).
 
 #pragma once
 
+#include <cstddef>
 #include <string>
 #include <unordered_map>
 
-#include "../../part_1/graph_impl.hpp" // Graph type used inside Job
+#include "../../part_1/shared_graph.hpp" // GraphSnapshot used inside Job
+#include "../../part_1/compressed_graph.hpp"
 
 // What kind of request this Job represents:
 enum class AlgKind 
@@ -42,7 +44,10 @@ struct Job
 	bool directed = false;       // if the graph is directed or undirected
 
 	// Inputs for computation
-	Graph graph{1, false};       // the graph to operate on
+	GraphSnapshot graph;         // the graph to operate on, shared read-only by all stages (moving a Job never copies it)
+	std::shared_ptr<const CompressedGraph> compressed; // set instead of graph for COMPRESS 1 requests
+	std::string preview;         // set instead of both for PREVIEW of a random graph: its text, written while generated
+	GraphFingerprint fingerprint; // content hash of the graph, keys the result cache
 	std::unordered_map<std::string,int> params; // SRC/SINK/K etc, for MST/SCC we may not need any
 
 	// Results (filled by stages; string to keep exact messages like errors)
@@ -50,6 +55,20 @@ struct Job
 	std::string res_scc;         // SCC count or error
 	std::string res_mst;         // MST weight or error
 	std::string res_cliques;     // cliques count or error
+
+	// Memory accounting: bytes charged against the server memory budget while the job is in the pipeline
+	std::size_t bytes = 0;
+
+	// Bytes held by the job now (graph, compressed graph or preview text, parameters and result strings)
+	std::size_t memory_bytes() const
+	{
+		std::size_t total = sizeof(Job);
+		if (graph) total += graph->memory_usage().total();
+		if (compressed) total += compressed->memory_bytes();
+		total += preview.capacity();
+		for (const auto& [name, value] : params) total += sizeof(value) + name.capacity();
+		return total + res_max_flow.capacity() + res_scc.capacity() + res_mst.capacity() + res_cliques.capacity();
+	}
 };
 
 // Pipeline lifecycle (to be implemented in server.cpp or a dedicated .cpp)
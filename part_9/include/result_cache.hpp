@@ -0,0 +1,92 @@
+/*
+@author : Roy Meoded
+@author : Yarin Keshet
+
+
+@description: Header-only thread-safe LRU cache of algorithm results, shared by the pipeline stages.
+- Keys describe a computation completely: graph fingerprint (see GraphFingerprint in part_1/graph_impl.hpp),
+  algorithm, orientation and parameters. Values are the exact result strings sent to clients.
+- Clients re-send the same seeded graph constantly (PREVIEW, then ALL on the same graph...), so a hit skips
+  the algorithm entirely.
+- get() refreshes the entry; put() evicts the least recently used entry once capacity is reached.
+
+Usage:
+- ResultCache cache(256);
+- std::string r; if (!cache.get(key, r)) { r = compute(); cache.put(key, r); }
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+class ResultCache
+{
+public:
+	// Constructor: maximum number of cached results (0 disables the cache):
+	explicit ResultCache(std::size_t capacity = 256)
+		: capacity_(capacity) {}
+
+	// Disable copy:
+	ResultCache(const ResultCache&) = delete;
+	ResultCache& operator=(const ResultCache&) = delete;
+
+	// Look up a result; on a hit copies it to out and marks the entry as most recently used:
+	bool get(const std::string& key, std::string& out)
+	{
+		std::lock_guard<std::mutex> lk(mu_);
+		auto it = index_.find(key);
+		if (it == index_.end()) return false;
+		lru_.splice(lru_.begin(), lru_, it->second); // move to front
+		out = it->second->second;
+		++hits_;
+		return true;
+	}
+
+	// Store (or refresh) a result, evicting the least recently used one if full:
+	void put(const std::string& key, const std::string& value)
+	{
+		if (capacity_ == 0) return;
+		std::lock_guard<std::mutex> lk(mu_);
+		auto it = index_.find(key);
+		if (it != index_.end())
+		{
+			it->second->second = value;
+			lru_.splice(lru_.begin(), lru_, it->second);
+			return;
+		}
+		if (lru_.size() == capacity_)
+		{
+			index_.erase(lru_.back().first);
+			lru_.pop_back();
+		}
+		lru_.emplace_front(key, value);
+		index_[key] = lru_.begin();
+	}
+
+	// Number of cached results / hits so far (non-blocking snapshots):
+	std::size_t size() const
+	{
+		std::lock_guard<std::mutex> lk(mu_);
+		return lru_.size();
+	}
+
+	std::size_t hits() const
+	{
+		std::lock_guard<std::mutex> lk(mu_);
+		return hits_;
+	}
+
+private:
+	using Entry = std::pair<std::string, std::string>;
+
+	std::size_t capacity_;
+	std::size_t hits_ = 0;
+	std::list<Entry> lru_; // front = most recently used
+	std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+	mutable std::mutex mu_;
+};